@@ -0,0 +1,300 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "bat/ads/ads_client.h"
+#include "bat/ads/pref_names.h"
+#include "brave/browser/brave_ads/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service_impl.h"
+#include "brave/components/brave_ads/browser/frequency_capping_helper.h"
+#include "brave/components/brave_ads/common/pref_names.h"
+#include "brave/components/l10n/browser/locale_helper_mock.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom-test-utils.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/test/browser_test.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_browser_tests --filter=BraveAdsMirroredPrefsBrowserTest.*
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+constexpr char kAdType[] = "ad_notification";
+constexpr char kConfirmationType[] = "served";
+
+const bat_ads::mojom::MirroredPref* FindMirroredPref(
+    const std::vector<bat_ads::mojom::MirroredPrefPtr>& prefs,
+    const std::string& path) {
+  for (const auto& pref : prefs) {
+    if (pref->path == path) {
+      return pref.get();
+    }
+  }
+
+  return nullptr;
+}
+
+// Stands in for the utility process. Records the mirrored prefs and ad event
+// notifications sent to the ads library, and drops the other calls.
+class TestBatAdsService : public bat_ads::mojom::BatAdsService,
+                          public bat_ads::mojom::BatAdsInterceptorForTesting {
+ public:
+  explicit TestBatAdsService(
+      mojo::PendingReceiver<bat_ads::mojom::BatAdsService> receiver)
+      : receiver_(this, std::move(receiver)) {
+    // The receiver goes out of scope, which disconnects |dropped_bat_ads_|.
+    auto dropped_receiver =
+        dropped_bat_ads_.BindNewEndpointAndPassDedicatedReceiver();
+  }
+
+  ~TestBatAdsService() override = default;
+
+  TestBatAdsService(const TestBatAdsService&) = delete;
+  TestBatAdsService& operator=(const TestBatAdsService&) = delete;
+
+  const std::vector<std::vector<bat_ads::mojom::MirroredPrefPtr>>&
+  mirrored_prefs() const {
+    return mirrored_prefs_;
+  }
+
+  int ad_events_changed_count() const { return ad_events_changed_count_; }
+
+  void WaitForMirroredPrefs(const size_t count) {
+    while (mirrored_prefs_.size() < count) {
+      base::RunLoop run_loop;
+      quit_closure_ = run_loop.QuitClosure();
+      run_loop.Run();
+    }
+  }
+
+  void WaitForAdEventsChanged(const int count) {
+    while (ad_events_changed_count_ < count) {
+      base::RunLoop run_loop;
+      quit_closure_ = run_loop.QuitClosure();
+      run_loop.Run();
+    }
+  }
+
+  // bat_ads::mojom::BatAdsService implementation
+  void Create(
+      mojo::PendingAssociatedRemote<bat_ads::mojom::BatAdsClient> client_info,
+      mojo::PendingAssociatedReceiver<bat_ads::mojom::BatAds> bat_ads,
+      CreateCallback callback) override {
+    bat_ads_client_ = std::move(client_info);
+    bat_ads_receiver_.reset();
+    bat_ads_receiver_.Bind(std::move(bat_ads));
+    std::move(callback).Run();
+  }
+
+  void SetEnvironment(const ads::mojom::Environment environment,
+                      SetEnvironmentCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void SetSysInfo(ads::mojom::SysInfoPtr sys_info,
+                  SetSysInfoCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void SetBuildChannel(ads::mojom::BuildChannelPtr build_channel,
+                       SetBuildChannelCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void SetDebug(const bool is_debug, SetDebugCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  // bat_ads::mojom::BatAdsInterceptorForTesting implementation
+  bat_ads::mojom::BatAds* GetForwardingInterface() override {
+    return dropped_bat_ads_.get();
+  }
+
+  void Initialize(InitializeCallback callback) override {
+    std::move(callback).Run(/* success */ true);
+  }
+
+  void Shutdown(ShutdownCallback callback) override {
+    std::move(callback).Run(/* success */ true);
+  }
+
+  void SetMirroredPrefs(
+      std::vector<bat_ads::mojom::MirroredPrefPtr> prefs) override {
+    mirrored_prefs_.push_back(std::move(prefs));
+    MaybeQuit();
+  }
+
+  void OnAdEventsChanged() override {
+    ++ad_events_changed_count_;
+    MaybeQuit();
+  }
+
+  void GetNewTabPageAd(GetNewTabPageAdCallback callback) override {
+    std::move(callback).Run(/* success */ false, /* json */ "");
+  }
+
+  void PurgeOrphanedAdEventsForType(
+      const ads::mojom::AdType ad_type,
+      PurgeOrphanedAdEventsForTypeCallback callback) override {
+    std::move(callback).Run(/* success */ true);
+  }
+
+ private:
+  void MaybeQuit() {
+    if (quit_closure_) {
+      std::move(quit_closure_).Run();
+    }
+  }
+
+  mojo::Receiver<bat_ads::mojom::BatAdsService> receiver_;
+  mojo::AssociatedReceiver<bat_ads::mojom::BatAds> bat_ads_receiver_{this};
+  mojo::PendingAssociatedRemote<bat_ads::mojom::BatAdsClient> bat_ads_client_;
+  // Disconnected, so calls forwarded to it are dropped.
+  mojo::AssociatedRemote<bat_ads::mojom::BatAds> dropped_bat_ads_;
+
+  std::vector<std::vector<bat_ads::mojom::MirroredPrefPtr>> mirrored_prefs_;
+  int ad_events_changed_count_ = 0;
+  base::OnceClosure quit_closure_;
+};
+
+}  // namespace
+
+class BraveAdsMirroredPrefsBrowserTest : public InProcessBrowserTest {
+ public:
+  BraveAdsMirroredPrefsBrowserTest() {
+    locale_helper_mock_ =
+        std::make_unique<NiceMock<brave_l10n::LocaleHelperMock>>();
+    ON_CALL(*locale_helper_mock_, GetLocale()).WillByDefault(Return("en_US"));
+  }
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    ads_service_ = static_cast<brave_ads::AdsServiceImpl*>(
+        brave_ads::AdsServiceFactory::GetForProfile(browser()->profile()));
+    ASSERT_NE(nullptr, ads_service_);
+
+    mojo::PendingRemote<bat_ads::mojom::BatAdsService> bat_ads_service;
+    bat_ads_service_ = std::make_unique<TestBatAdsService>(
+        bat_ads_service.InitWithNewPipeAndPassReceiver());
+    ads_service_->SetBatAdsServiceForTesting(std::move(bat_ads_service));
+
+    GetPrefs()->SetBoolean(ads::prefs::kEnabled, true);
+    bat_ads_service_->WaitForMirroredPrefs(1);
+  }
+
+  void TearDownOnMainThread() override {
+    ads_service_ = nullptr;
+
+    InProcessBrowserTest::TearDownOnMainThread();
+  }
+
+  PrefService* GetPrefs() const { return browser()->profile()->GetPrefs(); }
+
+  raw_ptr<brave_ads::AdsServiceImpl> ads_service_ = nullptr;
+  std::unique_ptr<TestBatAdsService> bat_ads_service_;
+  std::unique_ptr<brave_l10n::LocaleHelperMock> locale_helper_mock_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirroredPrefsBrowserTest,
+                       SendAllMirroredPrefsOnCreate) {
+  const auto& prefs = bat_ads_service_->mirrored_prefs().front();
+  EXPECT_LT(1U, prefs.size());
+
+  const bat_ads::mojom::MirroredPref* enabled =
+      FindMirroredPref(prefs, ads::prefs::kEnabled);
+  ASSERT_NE(nullptr, enabled);
+  EXPECT_EQ(base::Value(true), enabled->value);
+  EXPECT_TRUE(enabled->has_pref_path);
+
+  const bat_ads::mojom::MirroredPref* ads_per_hour =
+      FindMirroredPref(prefs, ads::prefs::kAdsPerHour);
+  ASSERT_NE(nullptr, ads_per_hour);
+  EXPECT_FALSE(ads_per_hour->has_pref_path);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirroredPrefsBrowserTest,
+                       SendChangedMirroredPref) {
+  base::RunLoop().RunUntilIdle();
+  const size_t count = bat_ads_service_->mirrored_prefs().size();
+
+  // Prefs which the ads library does not read are not sent.
+  GetPrefs()->SetInteger(brave_ads::prefs::kNotificationAdLastScreenPositionX,
+                         1);
+  GetPrefs()->SetInt64(ads::prefs::kAdsPerHour, 3);
+  bat_ads_service_->WaitForMirroredPrefs(count + 1);
+
+  const auto& prefs = bat_ads_service_->mirrored_prefs()[count];
+  ASSERT_EQ(1U, prefs.size());
+  EXPECT_EQ(ads::prefs::kAdsPerHour, prefs.front()->path);
+  EXPECT_EQ(
+      *GetPrefs()->FindPreference(ads::prefs::kAdsPerHour)->GetValue(),
+      prefs.front()->value);
+  EXPECT_TRUE(prefs.front()->has_pref_path);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirroredPrefsBrowserTest,
+                       SendAllMirroredPrefsAfterResetState) {
+  GetPrefs()->SetInt64(ads::prefs::kAdsPerHour, 3);
+  base::RunLoop().RunUntilIdle();
+  const size_t count = bat_ads_service_->mirrored_prefs().size();
+
+  // Clearing the prefs silently does not notify pref observers.
+  ads_service_->ResetAllState(/* should_shutdown */ false);
+  bat_ads_service_->WaitForMirroredPrefs(count + 1);
+
+  const auto& mirrored_prefs = bat_ads_service_->mirrored_prefs();
+  const auto& prefs = mirrored_prefs[count];
+  EXPECT_EQ(mirrored_prefs.front().size(), prefs.size());
+
+  const bat_ads::mojom::MirroredPref* enabled =
+      FindMirroredPref(prefs, ads::prefs::kEnabled);
+  ASSERT_NE(nullptr, enabled);
+  EXPECT_EQ(base::Value(false), enabled->value);
+  EXPECT_FALSE(enabled->has_pref_path);
+
+  const bat_ads::mojom::MirroredPref* ads_per_hour =
+      FindMirroredPref(prefs, ads::prefs::kAdsPerHour);
+  ASSERT_NE(nullptr, ads_per_hour);
+  EXPECT_FALSE(ads_per_hour->has_pref_path);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirroredPrefsBrowserTest,
+                       OnlyNotifyAdEventsChangedByOtherProfiles) {
+  const base::Time now = base::Time::Now();
+
+  // The ads library of this profile made these changes itself.
+  ads::AdsClient* ads_client = ads_service_;
+  ads_client->RecordAdEventForId("id", kAdType, kConfirmationType, now);
+
+  // Another profile recorded an ad event.
+  brave_ads::FrequencyCappingHelper::GetInstance()->RecordAdEventForId(
+      "id", kAdType, kConfirmationType, now);
+
+  ads_client->ResetAdEventsForId("id");
+
+  bat_ads_service_->WaitForAdEventsChanged(1);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, bat_ads_service_->ad_events_changed_count());
+}
@@ -164,7 +164,7 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     }
   }
   brave_perf_predictor::PerfPredictorTabHelper::DispatchBlockedEvent(
-      request_url.spec(), frame_tree_node_id);
+      request_url, frame_tree_node_id);
 }
 
 #if !BUILDFLAG(IS_ANDROID)
@@ -9,7 +9,12 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/bind.h"
+#include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/eth_nonce_tracker.h"
 #include "brave/components/brave_wallet/browser/eth_transaction.h"
@@ -61,6 +66,76 @@ class EthPendingTxTrackerUnitTest : public testing::Test {
 
   void WaitForResponse() { task_environment_.RunUntilIdle(); }
 
+  // How batch requests of receipt lookups are answered.
+  enum class BatchResponse {
+    kAnswered,
+    // Rejected with an error, as nodes without batch support do.
+    kNotSupported,
+    // Only the first lookup is answered, as nodes which cap batches do.
+    kCutShort,
+  };
+
+  // Answers receipt lookups with a successful receipt, counting the requests
+  // sent in |requests_count|.
+  void SetReceiptsInterceptor(
+      size_t* requests_count,
+      BatchResponse batch_response = BatchResponse::kAnswered) {
+    test_url_loader_factory()->SetInterceptor(base::BindLambdaForTesting(
+        [&, requests_count,
+         batch_response](const network::ResourceRequest& request) {
+          (*requests_count)++;
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          absl::optional<base::Value> requests =
+              base::JSONReader::Read(request_string);
+          ASSERT_TRUE(requests);
+          test_url_loader_factory()->ClearResponses();
+          const bool is_batch = requests->is_list();
+          if (is_batch && batch_response == BatchResponse::kNotSupported) {
+            test_url_loader_factory()->AddResponse(
+                request.url.spec(),
+                R"({"jsonrpc":"2.0","id":null,"error":{"code":-32600,)"
+                R"("message":"batch requests are not supported"}})");
+            return;
+          }
+
+          base::Value responses(base::Value::Type::LIST);
+          if (!is_batch) {
+            base::Value single_request = std::move(*requests);
+            requests = base::Value(base::Value::Type::LIST);
+            requests->Append(std::move(single_request));
+          }
+          for (const auto& batch_request : requests->GetList()) {
+            absl::optional<base::Value> response = base::JSONReader::Read(
+                R"({"jsonrpc":"2.0","result":{
+                  "transactionHash": "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+                  "transactionIndex":  "0x1",
+                  "blockNumber": "0xb",
+                  "blockHash": "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b",
+                  "cumulativeGasUsed": "0x33bc",
+                  "gasUsed": "0x4dc",
+                  "contractAddress": "0xb60e8dd61c5d32be8058bb8eb970870f07233155",
+                  "logs": [],
+                  "logsBloom": "0x00...0",
+                  "status": "0x1"}})");
+            ASSERT_TRUE(response);
+            const base::Value* id = batch_request.FindKey("id");
+            ASSERT_TRUE(id);
+            response->SetKey("id", id->Clone());
+            responses.Append(std::move(*response));
+            if (batch_response == BatchResponse::kCutShort)
+              break;
+          }
+          std::string response_string;
+          ASSERT_TRUE(base::JSONWriter::Write(
+              is_batch ? responses : responses.GetList()[0], &response_string));
+          test_url_loader_factory()->AddResponse(request.url.spec(),
+                                                 response_string);
+        }));
+  }
+
  private:
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
@@ -176,32 +251,16 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
   meta.set_status(mojom::TransactionStatus::Submitted);
   tx_state_manager.AddOrUpdateTx(meta);
 
-  test_url_loader_factory()->SetInterceptor(
-      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
-        test_url_loader_factory()->AddResponse(
-            request.url.spec(),
-            "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{"
-            "\"transactionHash\":"
-            "\"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce5682"
-            "38\","
-            "\"transactionIndex\":  \"0x1\","
-            "\"blockNumber\": \"0xb\","
-            "\"blockHash\": "
-            "\"0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d105"
-            "5b\","
-            "\"cumulativeGasUsed\": \"0x33bc\","
-            "\"gasUsed\": \"0x4dc\","
-            "\"contractAddress\": "
-            "\"0xb60e8dd61c5d32be8058bb8eb970870f07233155\","
-            "\"logs\": [],"
-            "\"logsBloom\": \"0x00...0\","
-            "\"status\": \"0x1\"}}");
-      }));
+  size_t requests_count = 0;
+  SetReceiptsInterceptor(&requests_count);
 
   size_t num_pending;
   EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
   EXPECT_EQ(3UL, num_pending);
   WaitForResponse();
+  // Receipts of the two transactions which are still pending are looked up
+  // with a single request.
+  EXPECT_EQ(1UL, requests_count);
   auto meta_from_state = tx_state_manager.GetEthTx("001");
   ASSERT_NE(meta_from_state, nullptr);
   EXPECT_EQ(meta_from_state->status(), mojom::TransactionStatus::Confirmed);
@@ -218,4 +277,145 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
             "0xb60e8dd61c5d32be8058bb8eb970870f07233155");
 }
 
+TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactionsWithoutBatches) {
+  JsonRpcService service(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  EthNonceTracker nonce_tracker(&tx_state_manager, &service);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+
+  const std::string addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress();
+  auto add_submitted_tx = [&](size_t nonce) {
+    EthTxMeta meta;
+    meta.set_id(base::NumberToString(nonce));
+    meta.set_from(addr);
+    meta.tx()->set_nonce(uint256_t(nonce));
+    meta.set_tx_hash(base::StringPrintf("0x%064zx", nonce));
+    meta.set_status(mojom::TransactionStatus::Submitted);
+    tx_state_manager.AddOrUpdateTx(meta);
+  };
+  add_submitted_tx(0);
+  add_submitted_tx(1);
+
+  size_t requests_count = 0;
+  SetReceiptsInterceptor(&requests_count, BatchResponse::kNotSupported);
+
+  size_t num_pending;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
+  WaitForResponse();
+  // The rejected batch and one request per transaction.
+  EXPECT_EQ(3UL, requests_count);
+  EXPECT_EQ(2UL, tx_state_manager
+                     .GetTransactionsByStatus(
+                         mojom::TransactionStatus::Confirmed, absl::nullopt)
+                     .size());
+
+  // The network is not sent batch requests anymore.
+  add_submitted_tx(2);
+  add_submitted_tx(3);
+  requests_count = 0;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
+  WaitForResponse();
+  EXPECT_EQ(2UL, requests_count);
+  EXPECT_EQ(4UL, tx_state_manager
+                     .GetTransactionsByStatus(
+                         mojom::TransactionStatus::Confirmed, absl::nullopt)
+                     .size());
+}
+
+TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactionsWithCutBatch) {
+  JsonRpcService service(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  EthNonceTracker nonce_tracker(&tx_state_manager, &service);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+
+  const std::string addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress();
+  auto add_submitted_tx = [&](size_t nonce) {
+    EthTxMeta meta;
+    meta.set_id(base::NumberToString(nonce));
+    meta.set_from(addr);
+    meta.tx()->set_nonce(uint256_t(nonce));
+    meta.set_tx_hash(base::StringPrintf("0x%064zx", nonce));
+    meta.set_status(mojom::TransactionStatus::Submitted);
+    tx_state_manager.AddOrUpdateTx(meta);
+  };
+  add_submitted_tx(0);
+  add_submitted_tx(1);
+
+  size_t requests_count = 0;
+  SetReceiptsInterceptor(&requests_count, BatchResponse::kCutShort);
+
+  size_t num_pending;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
+  WaitForResponse();
+  // The cut batch and one request per transaction.
+  EXPECT_EQ(3UL, requests_count);
+  EXPECT_EQ(2UL, tx_state_manager
+                     .GetTransactionsByStatus(
+                         mojom::TransactionStatus::Confirmed, absl::nullopt)
+                     .size());
+
+  // The network did not say it does not support batches, so the next lookup
+  // tries a batch again.
+  add_submitted_tx(2);
+  add_submitted_tx(3);
+  requests_count = 0;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
+  WaitForResponse();
+  EXPECT_EQ(3UL, requests_count);
+  EXPECT_EQ(4UL, tx_state_manager
+                     .GetTransactionsByStatus(
+                         mojom::TransactionStatus::Confirmed, absl::nullopt)
+                     .size());
+}
+
+TEST_F(EthPendingTxTrackerUnitTest, UpdateManyPendingTransactions) {
+  JsonRpcService service(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  EthNonceTracker nonce_tracker(&tx_state_manager, &service);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+
+  const std::string addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress();
+  const size_t kTxCount = 250;
+  for (size_t i = 0; i < kTxCount; ++i) {
+    EthTxMeta meta;
+    meta.set_id(base::NumberToString(i));
+    meta.set_from(addr);
+    meta.tx()->set_nonce(uint256_t(i));
+    meta.set_tx_hash(base::StringPrintf("0x%064zx", i));
+    meta.set_status(mojom::TransactionStatus::Submitted);
+    tx_state_manager.AddOrUpdateTx(meta);
+  }
+
+  size_t requests_count = 0;
+  SetReceiptsInterceptor(&requests_count);
+
+  size_t num_pending;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
+  EXPECT_EQ(kTxCount, num_pending);
+  WaitForResponse();
+  // One request per batch of at most 100 receipts, instead of one request per
+  // transaction.
+  EXPECT_EQ(3UL, requests_count);
+  EXPECT_TRUE(tx_state_manager
+                  .GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                           absl::nullopt)
+                  .empty());
+  EXPECT_EQ(kTxCount, tx_state_manager
+                          .GetTransactionsByStatus(
+                              mojom::TransactionStatus::Confirmed, absl::nullopt)
+                          .size());
+}
+
 }  // namespace brave_wallet
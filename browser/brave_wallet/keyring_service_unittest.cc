@@ -1196,6 +1196,29 @@ TEST_F(KeyringServiceUnitTest, LockAndUnlock) {
   }
 }
 
+TEST_F(KeyringServiceUnitTest, LockDropsCachedAccountAddresses) {
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  ASSERT_TRUE(AddAccount(&service, "Account 2", mojom::CoinType::ETH));
+
+  HDKeyring* keyring = service.GetHDKeyringById(mojom::kDefaultKeyringId);
+  ASSERT_TRUE(keyring);
+  const std::vector<std::string> accounts = keyring->GetAccounts();
+  ASSERT_EQ(accounts.size(), 2u);
+  EXPECT_EQ(keyring->account_addresses_, accounts);
+
+  service.Lock();
+  EXPECT_TRUE(service.keyrings_.empty());
+  EXPECT_FALSE(service.GetHDKeyringById(mojom::kDefaultKeyringId));
+
+  // Unlocking derives the keys and their addresses again.
+  ASSERT_TRUE(Unlock(&service, "brave"));
+  keyring = service.GetHDKeyringById(mojom::kDefaultKeyringId);
+  ASSERT_TRUE(keyring);
+  EXPECT_EQ(keyring->account_addresses_, accounts);
+  EXPECT_EQ(keyring->GetAccounts(), accounts);
+}
+
 TEST_F(KeyringServiceUnitTest, Reset) {
   KeyringService service(json_rpc_service(), GetPrefs());
   ASSERT_TRUE(CreateWallet(&service, "brave"));
@@ -5,7 +5,13 @@
 
 #include "brave/browser/ephemeral_storage/ephemeral_storage_browsertest.h"
 
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/run_loop.h"
 #include "base/strings/strcat.h"
+#include "base/test/bind.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "chrome/browser/content_settings/cookie_settings_factory.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -16,6 +22,7 @@
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "content/public/browser/storage_partition.h"
+#include "content/public/browser/tld_ephemeral_lifetime.h"
 #include "content/public/test/browser_test.h"
 #include "net/base/features.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
@@ -531,6 +538,81 @@ IN_PROC_BROWSER_TEST_F(
   EXPECT_EQ("name=bcom_simple", site_a_tab_values.iframe_2.cookies);
 }
 
+IN_PROC_BROWSER_TEST_F(EphemeralStorage1pBrowserTest,
+                       OpaqueOriginLocalStorageIsDeletedPerOrigin) {
+  const std::vector<GURL> site_urls = {a_site_ephemeral_storage_url_,
+                                       b_site_ephemeral_storage_url_,
+                                       c_site_ephemeral_storage_url_};
+  // Don't let the cleanup run on its own, so that all closed tabs are
+  // guaranteed to end up in the same batch.
+  content::TLDEphemeralLifetime::SetStorageCleanupDelayForTesting(
+      base::Days(1));
+
+  std::vector<WebContents*> site_tabs;
+  for (const GURL& site_url : site_urls) {
+    SetCookieSetting(site_url, CONTENT_SETTING_SESSION_ONLY);
+    WebContents* site_tab = LoadURLInNewTab(site_url);
+    SetValuesInFrames(site_tab, site_url.host(), "from=" + site_url.host());
+    EXPECT_EQ(site_url.host(),
+              GetValuesFromFrames(site_tab).main_frame.local_storage);
+    site_tabs.push_back(site_tab);
+  }
+
+  int delete_cookies_requests_count = 0;
+  std::vector<url::Origin> deleted_local_storage_origins;
+  base::RunLoop run_loop;
+  // Every site keyed its first-party local storage with an opaque origin.
+  auto quit_when_deleted = [&]() {
+    if (delete_cookies_requests_count > 0 &&
+        deleted_local_storage_origins.size() >= site_urls.size()) {
+      run_loop.Quit();
+    }
+  };
+  content::TLDEphemeralLifetime::SetOnCookiesDeletedCallbackForTesting(
+      base::BindLambdaForTesting(
+          [&](const std::vector<std::string>& ephemeral_storage_domains,
+              uint32_t num_deleted) {
+            ++delete_cookies_requests_count;
+            quit_when_deleted();
+          }));
+  content::TLDEphemeralLifetime::SetOnLocalStorageDeletedCallbackForTesting(
+      base::BindLambdaForTesting([&](const url::Origin& opaque_origin) {
+        deleted_local_storage_origins.push_back(opaque_origin);
+        quit_when_deleted();
+      }));
+
+  for (WebContents* site_tab : site_tabs)
+    CloseWebContents(site_tab);
+  WaitForCleanupAfterKeepAlive();
+  EXPECT_EQ(0, delete_cookies_requests_count);
+  EXPECT_TRUE(deleted_local_storage_origins.empty());
+
+  content::TLDEphemeralLifetime::RunPendingStorageCleanupsForTesting();
+  run_loop.Run();
+  base::RunLoop().RunUntilIdle();
+  content::TLDEphemeralLifetime::SetOnCookiesDeletedCallbackForTesting(
+      base::NullCallback());
+  content::TLDEphemeralLifetime::SetOnLocalStorageDeletedCallbackForTesting(
+      base::NullCallback());
+
+  // Cookies of all sites are deleted with a single request, while local
+  // storage is deleted with one request per opaque origin.
+  EXPECT_EQ(1, delete_cookies_requests_count);
+  const std::set<url::Origin> unique_origins(
+      deleted_local_storage_origins.begin(),
+      deleted_local_storage_origins.end());
+  EXPECT_EQ(unique_origins.size(), deleted_local_storage_origins.size());
+  for (const url::Origin& origin : deleted_local_storage_origins)
+    EXPECT_TRUE(origin.opaque());
+
+  for (const GURL& site_url : site_urls) {
+    ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), site_url));
+    ExpectValuesFromFramesAreEmpty(
+        FROM_HERE, GetValuesFromFrames(
+                       browser()->tab_strip_model()->GetActiveWebContents()));
+  }
+}
+
 // By default SESSION_ONLY setting means that data for a website should be
 // deleted after a restart, but this also implicitly change how a website
 // behaves in 3p context: when the setting is explicit, Chromium removes 3p
@@ -6,6 +6,8 @@
 #include "brave/browser/ephemeral_storage/ephemeral_storage_browsertest.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/path_service.h"
@@ -28,6 +30,7 @@
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/storage_partition.h"
+#include "content/public/browser/tld_ephemeral_lifetime.h"
 #include "content/public/common/content_paths.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/test/browser_test.h"
@@ -163,6 +166,8 @@ void EphemeralStorageBrowserTest::SetUpOnMainThread() {
 
   ephemeral_storage::EphemeralStorageTabHelper::SetKeepAliveTimeDelayForTesting(
       base::Seconds(kKeepAliveInterval));
+  content::TLDEphemeralLifetime::SetStorageCleanupDelayForTesting(
+      base::TimeDelta());
 }
 
 void EphemeralStorageBrowserTest::SetUpHttpsServer() {
@@ -286,6 +291,8 @@ void EphemeralStorageBrowserTest::WaitForCleanupAfterKeepAlive() {
   base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
       FROM_HERE, run_loop.QuitClosure(), base::Seconds(kKeepAliveInterval));
   run_loop.Run();
+  // Let the storage cleanup scheduled at the end of the keepalive run.
+  base::RunLoop().RunUntilIdle();
 }
 
 void EphemeralStorageBrowserTest::ExpectValuesFromFramesAreEmpty(
@@ -676,6 +683,64 @@ IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
   EXPECT_EQ("", values_after.iframe_2.cookies);
 }
 
+IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
+                       ClosingManyTabsBatchesEphemeralStorageCleanup) {
+  constexpr int kSitesCount = 20;
+  // Don't let the cleanup run on its own, so that all closed tabs are
+  // guaranteed to end up in the same batch.
+  content::TLDEphemeralLifetime::SetStorageCleanupDelayForTesting(
+      base::Days(1));
+
+  std::vector<WebContents*> site_tabs;
+  for (int i = 0; i < kSitesCount; ++i) {
+    const std::string host = base::StringPrintf("site%d.com", i);
+    WebContents* site_tab = LoadURLInNewTab(
+        https_server_.GetURL(host, "/ephemeral_storage.html"));
+    SetValuesInFrames(site_tab, host + " value", "from=" + host);
+    EXPECT_EQ("from=" + host, GetValuesFromFrames(site_tab).iframe_1.cookies);
+    site_tabs.push_back(site_tab);
+  }
+
+  std::vector<std::vector<std::string>> delete_cookies_requests;
+  uint32_t deleted_cookies_count = 0;
+  base::RunLoop run_loop;
+  content::TLDEphemeralLifetime::SetOnCookiesDeletedCallbackForTesting(
+      base::BindLambdaForTesting(
+          [&](const std::vector<std::string>& ephemeral_storage_domains,
+              uint32_t num_deleted) {
+            delete_cookies_requests.push_back(ephemeral_storage_domains);
+            deleted_cookies_count += num_deleted;
+            run_loop.Quit();
+          }));
+
+  for (WebContents* site_tab : site_tabs)
+    CloseWebContents(site_tab);
+  WaitForCleanupAfterKeepAlive();
+  EXPECT_TRUE(delete_cookies_requests.empty());
+
+  content::TLDEphemeralLifetime::RunPendingStorageCleanupsForTesting();
+  run_loop.Run();
+  base::RunLoop().RunUntilIdle();
+  content::TLDEphemeralLifetime::SetOnCookiesDeletedCallbackForTesting(
+      base::NullCallback());
+
+  // All sites should be cleaned up with a single DeleteCookies request.
+  ASSERT_EQ(1u, delete_cookies_requests.size());
+  EXPECT_EQ(static_cast<size_t>(kSitesCount),
+            delete_cookies_requests[0].size());
+  EXPECT_GE(deleted_cookies_count, static_cast<uint32_t>(kSitesCount));
+
+  for (int i = 0; i < kSitesCount; i += kSitesCount / 4) {
+    const std::string host = base::StringPrintf("site%d.com", i);
+    ASSERT_TRUE(ui_test_utils::NavigateToURL(
+        browser(), https_server_.GetURL(host, "/ephemeral_storage.html")));
+    ValuesFromFrames values = GetValuesFromFrames(
+        browser()->tab_strip_model()->GetActiveWebContents());
+    EXPECT_EQ(nullptr, values.iframe_1.local_storage);
+    EXPECT_EQ("", values.iframe_1.cookies);
+  }
+}
+
 IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
                        ReloadDoesNotClearEphemeralStorage) {
   ASSERT_TRUE(ui_test_utils::NavigateToURL(
@@ -12,6 +12,7 @@
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "brave/browser/ipfs/ipfs_blob_context_getter_factory.h"
+#include "brave/components/ipfs/import/ipfs_folder_import_plan.h"
 #include "chrome/test/base/testing_profile.h"
 #include "content/public/test/browser_task_environment.h"
 #include "services/network/public/cpp/data_element.h"
@@ -142,4 +143,49 @@ TEST_F(IpfsNetwrokUtilsUnitTest, CreateRequestForFolderTest) {
   run_loop.Run();
 }
 
+TEST_F(IpfsNetwrokUtilsUnitTest, CreateImportFolderPlanSingleBatch) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  CreateCustomTestFile(dir.GetPath(), "a.txt", "a");
+  base::FilePath sub_dir = dir.GetPath().AppendASCII("sub");
+  ASSERT_TRUE(base::CreateDirectory(sub_dir));
+  CreateCustomTestFile(sub_dir, "1.txt", "1");
+  CreateCustomTestFile(sub_dir, "2.txt", "2");
+
+  ImportFolderPlan plan = CreateImportFolderPlan(dir.GetPath(), 100, 1024);
+  ASSERT_EQ(plan.batches.size(), 1u);
+  EXPECT_TRUE(plan.split_directories.empty());
+  EXPECT_EQ(plan.batches[0].units, std::vector<std::string>({"a.txt", "sub"}));
+  EXPECT_EQ(plan.batches[0].file_count, 3u);
+  // a.txt, sub, sub/1.txt and sub/2.txt
+  EXPECT_EQ(plan.batches[0].entries.size(), 4u);
+}
+
+TEST_F(IpfsNetwrokUtilsUnitTest, CreateImportFolderPlanSplitsDirectories) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  CreateCustomTestFile(dir.GetPath(), "a.txt", "a");
+  base::FilePath big_dir = dir.GetPath().AppendASCII("big");
+  ASSERT_TRUE(base::CreateDirectory(big_dir));
+  CreateCustomTestFile(big_dir, "x.txt", "x");
+  CreateCustomTestFile(big_dir, "y.txt", "y");
+  base::FilePath sub_dir = dir.GetPath().AppendASCII("sub");
+  ASSERT_TRUE(base::CreateDirectory(sub_dir));
+  CreateCustomTestFile(sub_dir, "1.txt", "1");
+  CreateCustomTestFile(sub_dir, "2.txt", "2");
+  CreateCustomTestFile(sub_dir, "3.txt", "3");
+
+  ImportFolderPlan plan = CreateImportFolderPlan(dir.GetPath(), 2, 1024);
+  EXPECT_EQ(plan.split_directories, std::vector<std::string>({"sub"}));
+  ASSERT_EQ(plan.batches.size(), 4u);
+  EXPECT_EQ(plan.batches[0].units, std::vector<std::string>({"a.txt"}));
+  EXPECT_EQ(plan.batches[1].units, std::vector<std::string>({"big"}));
+  EXPECT_EQ(plan.batches[2].units,
+            std::vector<std::string>({"sub/1.txt", "sub/2.txt"}));
+  EXPECT_EQ(plan.batches[3].units, std::vector<std::string>({"sub/3.txt"}));
+  // Batches adding files of a split directory also upload the directory.
+  ASSERT_EQ(plan.batches[3].entries.size(), 2u);
+  EXPECT_EQ(plan.batches[3].entries[0].path, sub_dir);
+}
+
 }  // namespace ipfs
@@ -3,14 +3,23 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "base/base64.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/memory/raw_ptr.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/strcat.h"
 #include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/test/bind.h"
 #include "base/test/mock_callback.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/ipfs/ipfs_blob_context_getter_factory.h"
 #include "brave/browser/ipfs/ipfs_service_factory.h"
@@ -19,6 +28,7 @@
 #include "brave/components/ipfs/brave_ipfs_client_updater.h"
 #include "brave/components/ipfs/features.h"
 #include "brave/components/ipfs/import/imported_data.h"
+#include "brave/components/ipfs/import/ipfs_import_worker_base.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_service.h"
 #include "brave/components/ipfs/ipfs_utils.h"
@@ -29,6 +39,7 @@
 #include "chrome/test/base/in_process_browser_test.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/storage_partition.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/content_mock_cert_verifier.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -36,6 +47,7 @@
 #include "net/test/embedded_test_server/http_request.h"
 #include "net/test/embedded_test_server/http_response.h"
 #include "net/test/url_request/url_request_failed_job.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
 
 namespace {
 const char kTestLinkImportPath[] = "/link.png";
@@ -323,6 +335,38 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return nullptr;
   }
 
+  // Stubs the daemon for a folder imported in batches. Runs on the test
+  // server's thread.
+  std::unique_ptr<net::test_server::HttpResponse> HandleFolderImportRequests(
+      const std::string& folder_name,
+      const net::test_server::HttpRequest& request) {
+    base::AutoLock lock(folder_import_lock_);
+    const GURL gurl = request.GetURL();
+    folder_import_requests_.push_back(std::string(gurl.path_piece()));
+
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    http_response->set_code(net::HTTP_OK);
+    http_response->set_content_type("application/json");
+    if (gurl.path_piece() == kImportAddPath) {
+      if (failing_add_requests_ > 0) {
+        failing_add_requests_--;
+        http_response->set_code(net::HTTP_INTERNAL_SERVER_ERROR);
+        return http_response;
+      }
+      http_response->set_content(base::StringPrintf(
+          R"({"Name":"%s", "Size":"1", "Hash": "QmBatch%zu"})",
+          folder_name.c_str(), folder_import_requests_.size()));
+    } else if (gurl.path_piece() == kImportCopyPath && fail_folder_compose_) {
+      http_response->set_code(net::HTTP_INTERNAL_SERVER_ERROR);
+    } else if (gurl.path_piece() == kImportStatPath) {
+      http_response->set_content(
+          R"({"Hash":"QmFolder", "Size":0, "CumulativeSize":1234,)"
+          R"( "Blocks":3, "Type":"directory"})");
+    }
+    return http_response;
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleGetNodeInfo(
       const net::test_server::HttpRequest& request) {
     const GURL gurl = request.GetURL();
@@ -627,6 +671,44 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     ASSERT_FALSE(success);
   }
 
+  // Imports |folder| with one file per batch, so every file and every split
+  // directory is uploaded and composed separately.
+  ImportedData ImportFolderInBatches(const base::FilePath& folder) {
+    IpfsBlobContextGetterFactory blob_context_getter_factory(
+        browser()->profile());
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory =
+        browser()
+            ->profile()
+            ->GetDefaultStoragePartition()
+            ->GetURLLoaderFactoryForBrowserProcess();
+    ImportedData result;
+    base::RunLoop run_loop;
+    IpfsImportWorkerBase worker(
+        &blob_context_getter_factory, url_loader_factory.get(),
+        test_server_->base_url(),
+        base::BindLambdaForTesting([&](const ImportedData& data) {
+          result = data;
+          run_loop.Quit();
+        }));
+    worker.SetFolderImportLimits(1, 1024, 2);
+    worker.ImportFolder(folder);
+    run_loop.Run();
+    return result;
+  }
+
+  void SetFolderImportFailures(int failing_add_requests,
+                               bool fail_folder_compose) {
+    base::AutoLock lock(folder_import_lock_);
+    failing_add_requests_ = failing_add_requests;
+    fail_folder_compose_ = fail_folder_compose;
+  }
+
+  size_t CountFolderImportRequests(const std::string& path) {
+    base::AutoLock lock(folder_import_lock_);
+    return std::count(folder_import_requests_.begin(),
+                      folder_import_requests_.end(), path);
+  }
+
   void WaitForRequest() {
     if (wait_for_request_) {
       return;
@@ -645,6 +727,12 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
   std::unique_ptr<net::EmbeddedTestServer> test_server_;
   raw_ptr<IpfsService> ipfs_service_ = nullptr;
   base::test::ScopedFeatureList feature_list_;
+
+  // Shared with the test server's thread.
+  base::Lock folder_import_lock_;
+  std::vector<std::string> folder_import_requests_;
+  int failing_add_requests_ = 0;
+  bool fail_folder_compose_ = false;
 };
 
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, StartSuccessAndLaunch) {
@@ -1142,6 +1230,54 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportDirectoryToIpfsSuccess) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFolderInBatches) {
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath folder = temp_dir.GetPath().AppendASCII("folder");
+  base::FilePath sub_dir = folder.AppendASCII("sub");
+  ASSERT_TRUE(base::CreateDirectory(sub_dir));
+  ASSERT_TRUE(base::WriteFile(folder.AppendASCII("a.txt"), "a"));
+  ASSERT_TRUE(base::WriteFile(sub_dir.AppendASCII("1.txt"), "1"));
+  ASSERT_TRUE(base::WriteFile(sub_dir.AppendASCII("2.txt"), "2"));
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleFolderImportRequests,
+                          base::Unretained(this), std::string("folder")));
+  SetFolderImportFailures(1, false);
+
+  ImportedData data = ImportFolderInBatches(folder);
+
+  EXPECT_EQ(data.state, IPFS_IMPORT_SUCCESS);
+  EXPECT_EQ(data.hash, "QmFolder");
+  EXPECT_EQ(data.size, 1234);
+  // a.txt, sub/1.txt and sub/2.txt plus the retried batch.
+  EXPECT_EQ(CountFolderImportRequests(kImportAddPath), 4u);
+  EXPECT_EQ(CountFolderImportRequests(kImportStatPath), 1u);
+  EXPECT_EQ(CountFolderImportRequests(kImportRemovePath), 1u);
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFolderComposeFailure) {
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath folder = temp_dir.GetPath().AppendASCII("folder");
+  ASSERT_TRUE(base::CreateDirectory(folder));
+  ASSERT_TRUE(base::WriteFile(folder.AppendASCII("a.txt"), "a"));
+  ASSERT_TRUE(base::WriteFile(folder.AppendASCII("b.txt"), "b"));
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleFolderImportRequests,
+                          base::Unretained(this), std::string("folder")));
+  SetFolderImportFailures(0, true);
+
+  ImportedData data = ImportFolderInBatches(folder);
+
+  EXPECT_EQ(data.state, IPFS_IMPORT_ERROR_MOVE_FAILED);
+  EXPECT_EQ(CountFolderImportRequests(kImportAddPath), 2u);
+  EXPECT_EQ(CountFolderImportRequests(kImportStatPath), 0u);
+  // The staging directory is removed although composing failed.
+  EXPECT_EQ(CountFolderImportRequests(kImportRemovePath), 1u);
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportAndPinDirectorySuccess) {
   std::string expected_response =
       R"({"Name":"autoplay-whitelist-data", "Size":"567857", "Hash": "QmYbK4SLa"})";
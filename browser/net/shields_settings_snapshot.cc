@@ -0,0 +1,87 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_snapshot.h"
+
+#include <memory>
+#include <utility>
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+const char kShieldsSettingsSnapshotKey[] = "brave_shields_settings_snapshot";
+
+}  // namespace
+
+ShieldsSettingsSnapshot::ShieldsSettingsSnapshot(HostContentSettingsMap* map)
+    : map_(map), settings_(kMaxSize) {
+  observation_.Observe(map_.get());
+}
+
+ShieldsSettingsSnapshot::~ShieldsSettingsSnapshot() = default;
+
+// static
+ShieldsSettingsSnapshot* ShieldsSettingsSnapshot::GetForBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto* snapshot = static_cast<ShieldsSettingsSnapshot*>(
+      browser_context->GetUserData(kShieldsSettingsSnapshotKey));
+  if (!snapshot) {
+    auto* map = HostContentSettingsMapFactory::GetForProfile(
+        Profile::FromBrowserContext(browser_context));
+    auto new_snapshot = std::make_unique<ShieldsSettingsSnapshot>(map);
+    snapshot = new_snapshot.get();
+    browser_context->SetUserData(kShieldsSettingsSnapshotKey,
+                                 std::move(new_snapshot));
+  }
+  return snapshot;
+}
+
+const ShieldsSettings& ShieldsSettingsSnapshot::GetSettings(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = settings_.Get(url.spec());
+  if (it != settings_.end())
+    return it->second;
+
+  ShieldsSettings settings;
+  settings.shields_up = brave_shields::GetBraveShieldsEnabled(map_.get(), url);
+  settings.allow_ads = brave_shields::GetAdControlType(map_.get(), url) ==
+                       brave_shields::ControlType::ALLOW;
+  // Currently, "aggressive" mode is registered as a cosmetic filtering control
+  // type, even though it can also affect network blocking.
+  settings.aggressive_blocking =
+      brave_shields::GetCosmeticFilteringControlType(map_.get(), url) ==
+      brave_shields::ControlType::BLOCK;
+  settings.allow_http_upgradable_resource =
+      !brave_shields::GetHTTPSEverywhereEnabled(map_.get(), url);
+  settings.allow_referrers =
+      brave_shields::AreReferrersAllowed(map_.get(), url);
+  return settings_.Put(url.spec(), settings)->second;
+}
+
+void ShieldsSettingsSnapshot::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsTypeSet content_type_set) {
+  if (content_type_set.Contains(ContentSettingsType::BRAVE_SHIELDS) ||
+      content_type_set.Contains(ContentSettingsType::BRAVE_ADS) ||
+      content_type_set.Contains(
+          ContentSettingsType::BRAVE_COSMETIC_FILTERING) ||
+      content_type_set.Contains(
+          ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES) ||
+      content_type_set.Contains(ContentSettingsType::BRAVE_REFERRERS)) {
+    settings_.Clear();
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,72 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_SHIELDS_SETTINGS_SNAPSHOT_H_
+#define BRAVE_BROWSER_NET_SHIELDS_SETTINGS_SNAPSHOT_H_
+
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/scoped_observation.h"
+#include "base/supports_user_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+
+class GURL;
+
+namespace content {
+class BrowserContext;
+}
+
+namespace brave {
+
+// The Shields settings BraveRequestInfo::MakeCTX needs for a site.
+struct ShieldsSettings {
+  bool shields_up = true;
+  bool allow_ads = false;
+  bool aggressive_blocking = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_referrers = false;
+};
+
+// Per-profile cache of ShieldsSettings keyed by site URL, so building the
+// context of a request does not query HostContentSettingsMap again and again
+// for the same top frame. All the cached settings are dropped whenever one of
+// the content settings they are read from changes.
+class ShieldsSettingsSnapshot : public base::SupportsUserData::Data,
+                                public content_settings::Observer {
+ public:
+  static constexpr size_t kMaxSize = 256;
+
+  explicit ShieldsSettingsSnapshot(HostContentSettingsMap* map);
+  ~ShieldsSettingsSnapshot() override;
+  ShieldsSettingsSnapshot(const ShieldsSettingsSnapshot&) = delete;
+  ShieldsSettingsSnapshot& operator=(const ShieldsSettingsSnapshot&) = delete;
+
+  static ShieldsSettingsSnapshot* GetForBrowserContext(
+      content::BrowserContext* browser_context);
+
+  const ShieldsSettings& GetSettings(const GURL& url);
+
+  size_t size() const { return settings_.size(); }
+
+ private:
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsTypeSet content_type_set) override;
+
+  // Keeps the map alive until the observation is reset.
+  scoped_refptr<HostContentSettingsMap> map_;
+  // URL spec -> settings.
+  base::HashingLRUCache<std::string, ShieldsSettings> settings_;
+  base::ScopedObservation<HostContentSettingsMap, content_settings::Observer>
+      observation_{this};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_SHIELDS_SETTINGS_SNAPSHOT_H_
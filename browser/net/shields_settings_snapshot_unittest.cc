@@ -0,0 +1,146 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_snapshot.h"
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "brave/browser/net/url_context.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/isolation_info.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace brave {
+
+class ShieldsSettingsSnapshotTest : public testing::Test {
+ public:
+  ShieldsSettingsSnapshotTest() = default;
+  ~ShieldsSettingsSnapshotTest() override = default;
+
+ protected:
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(&profile_);
+  }
+
+  ShieldsSettingsSnapshot* snapshot() {
+    return ShieldsSettingsSnapshot::GetForBrowserContext(&profile_);
+  }
+
+  void SetSiteSetting(const std::string& site,
+                      ContentSettingsType type,
+                      ContentSetting setting) {
+    map()->SetContentSettingCustomScope(
+        ContentSettingsPattern::FromString("[*.]" + site),
+        ContentSettingsPattern::Wildcard(), type, setting);
+  }
+
+  std::shared_ptr<BraveRequestInfo> MakeCTX(const GURL& url,
+                                            const GURL& top_frame_url) {
+    network::ResourceRequest request;
+    request.url = url;
+    request.method = "GET";
+    request.trusted_params = network::ResourceRequest::TrustedParams();
+    request.trusted_params->isolation_info =
+        net::IsolationInfo::CreateForInternalRequest(
+            url::Origin::Create(top_frame_url));
+    return BraveRequestInfo::MakeCTX(request, 0, 0, 1, &profile_, nullptr);
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+};
+
+TEST_F(ShieldsSettingsSnapshotTest, SettingsFollowContentSettings) {
+  const GURL url("https://example.com/");
+  EXPECT_TRUE(snapshot()->GetSettings(url).shields_up);
+  EXPECT_FALSE(snapshot()->GetSettings(url).allow_ads);
+  EXPECT_EQ(1u, snapshot()->size());
+
+  SetSiteSetting("example.com", ContentSettingsType::BRAVE_SHIELDS,
+                 CONTENT_SETTING_BLOCK);
+  EXPECT_EQ(0u, snapshot()->size());
+  EXPECT_FALSE(snapshot()->GetSettings(url).shields_up);
+
+  SetSiteSetting("example.com", ContentSettingsType::BRAVE_ADS,
+                 CONTENT_SETTING_ALLOW);
+  EXPECT_TRUE(snapshot()->GetSettings(url).allow_ads);
+
+  SetSiteSetting("example.com", ContentSettingsType::BRAVE_REFERRERS,
+                 CONTENT_SETTING_ALLOW);
+  EXPECT_TRUE(snapshot()->GetSettings(url).allow_referrers);
+
+  SetSiteSetting("example.com",
+                 ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES,
+                 CONTENT_SETTING_ALLOW);
+  EXPECT_TRUE(snapshot()->GetSettings(url).allow_http_upgradable_resource);
+
+  // Other sites are not affected.
+  EXPECT_TRUE(snapshot()->GetSettings(GURL("https://brave.com/")).shields_up);
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, UnrelatedSettingsKeepSnapshot) {
+  snapshot()->GetSettings(GURL("https://example.com/"));
+  EXPECT_EQ(1u, snapshot()->size());
+
+  SetSiteSetting("example.com", ContentSettingsType::JAVASCRIPT,
+                 CONTENT_SETTING_BLOCK);
+  EXPECT_EQ(1u, snapshot()->size());
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, Bounded) {
+  for (size_t i = 0; i < ShieldsSettingsSnapshot::kMaxSize * 2; ++i) {
+    snapshot()->GetSettings(
+        GURL("https://site" + base::NumberToString(i) + ".com/"));
+  }
+  EXPECT_EQ(ShieldsSettingsSnapshot::kMaxSize, snapshot()->size());
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, MakeCTX) {
+  SetSiteSetting("example.com", ContentSettingsType::BRAVE_SHIELDS,
+                 CONTENT_SETTING_BLOCK);
+  auto ctx = MakeCTX(GURL("https://ads.com/ad.js"),
+                     GURL("https://www.example.com/"));
+  EXPECT_EQ(GURL("https://www.example.com/"), ctx->tab_origin);
+  EXPECT_FALSE(ctx->allow_brave_shields);
+
+  ctx = MakeCTX(GURL("https://ads.com/ad.js"), GURL("https://brave.com/"));
+  EXPECT_TRUE(ctx->allow_brave_shields);
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, MakeCTXWithManyExceptions) {
+  constexpr int kSitesCount = 5000;
+  constexpr int kRequestsCount = 100000;
+
+  for (int i = 0; i < kSitesCount; ++i) {
+    const std::string site = "site" + base::NumberToString(i) + ".com";
+    SetSiteSetting(site, ContentSettingsType::BRAVE_SHIELDS,
+                   i % 2 == 1 ? CONTENT_SETTING_BLOCK : CONTENT_SETTING_ALLOW);
+    SetSiteSetting(site, ContentSettingsType::BRAVE_ADS,
+                   CONTENT_SETTING_ALLOW);
+    SetSiteSetting(site, ContentSettingsType::BRAVE_COSMETIC_FILTERING,
+                   CONTENT_SETTING_BLOCK);
+  }
+
+  // A handful of tabs, each making many requests.
+  const GURL request_url("https://cdn.example.com/script.js");
+  int shields_up_count = 0;
+  for (int i = 0; i < kRequestsCount; ++i) {
+    const GURL top_frame_url("https://site" + base::NumberToString(i % 8) +
+                             ".com/");
+    if (MakeCTX(request_url, top_frame_url)->allow_brave_shields)
+      ++shields_up_count;
+  }
+  EXPECT_EQ(kRequestsCount / 2, shields_up_count);
+}
+
+}  // namespace brave
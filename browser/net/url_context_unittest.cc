@@ -0,0 +1,64 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_context.h"
+
+#include <memory>
+#include <string>
+
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+class BraveRequestInfoTest : public testing::Test {
+ public:
+  BraveRequestInfoTest() = default;
+  ~BraveRequestInfoTest() override = default;
+
+ protected:
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+};
+
+TEST_F(BraveRequestInfoTest, UploadDataIsSharedWithRequest) {
+  constexpr size_t kBodySize = 50 * 1024 * 1024;
+
+  network::ResourceRequest request;
+  request.url = GURL("https://example.com/upload");
+  request.method = "POST";
+  request.request_body = new network::ResourceRequestBody();
+  request.request_body->AppendBytes(std::string(kBodySize / 2, 'a').data(),
+                                    kBodySize / 2);
+  request.request_body->AppendBytes(std::string(kBodySize / 2, 'b').data(),
+                                    kBodySize / 2);
+
+  auto ctx = BraveRequestInfo::MakeCTX(request, 0, 0, 1, &profile_, nullptr);
+  // Stages and redirects create a new context for the same request.
+  auto next_ctx = BraveRequestInfo::MakeCTX(request, 0, 0, 1, &profile_, ctx);
+  EXPECT_EQ(request.request_body, ctx->request_body);
+  EXPECT_EQ(request.request_body, next_ctx->request_body);
+
+  const std::string upload_data = next_ctx->GetUploadData();
+  ASSERT_EQ(kBodySize, upload_data.size());
+  EXPECT_EQ('a', upload_data.front());
+  EXPECT_EQ('b', upload_data.back());
+}
+
+TEST_F(BraveRequestInfoTest, NoUploadData) {
+  network::ResourceRequest request;
+  request.url = GURL("https://example.com/");
+  request.method = "GET";
+
+  auto ctx = BraveRequestInfo::MakeCTX(request, 0, 0, 1, &profile_, nullptr);
+  EXPECT_FALSE(ctx->request_body);
+  EXPECT_TRUE(ctx->GetUploadData().empty());
+}
+
+}  // namespace brave
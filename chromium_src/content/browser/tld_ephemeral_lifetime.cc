@@ -6,9 +6,13 @@
 #include "content/public/browser/tld_ephemeral_lifetime.h"
 
 #include <map>
+#include <utility>
 
+#include "base/containers/flat_set.h"
 #include "base/no_destructor.h"
+#include "base/timer/timer.h"
 #include "content/browser/dom_storage/dom_storage_context_wrapper.h"
+#include "content/browser/storage_partition_impl.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 #include "third_party/blink/public/common/storage_key/storage_key.h"
 
@@ -28,6 +32,107 @@ TLDEphemeralLifetimeMap& active_tld_storage_areas() {
   return *active_storage_areas.get();
 }
 
+// Ephemeral storage of TLD lifetimes which ended within a short window is
+// cleaned up together, so that closing many tabs at once results in a single
+// cookie deletion request per StoragePartition instead of one per site.
+constexpr base::TimeDelta kStorageCleanupDelay = base::Milliseconds(500);
+
+base::TimeDelta g_storage_cleanup_delay_for_testing = base::TimeDelta::Min();
+
+TLDEphemeralLifetime::OnCookiesDeletedCallback&
+cookies_deleted_callback_for_testing() {
+  static base::NoDestructor<TLDEphemeralLifetime::OnCookiesDeletedCallback>
+      callback;
+  return *callback.get();
+}
+
+TLDEphemeralLifetime::OnLocalStorageDeletedCallback&
+local_storage_deleted_callback_for_testing() {
+  static base::NoDestructor<
+      TLDEphemeralLifetime::OnLocalStorageDeletedCallback>
+      callback;
+  return *callback.get();
+}
+
+void OnCookiesDeleted(const std::vector<std::string>& ephemeral_storage_domains,
+                      uint32_t num_deleted) {
+  if (cookies_deleted_callback_for_testing())
+    cookies_deleted_callback_for_testing().Run(ephemeral_storage_domains,
+                                               num_deleted);
+}
+
+void OnLocalStorageDeleted(const url::Origin& opaque_origin) {
+  if (local_storage_deleted_callback_for_testing())
+    local_storage_deleted_callback_for_testing().Run(opaque_origin);
+}
+
+struct PendingStorageCleanup {
+  base::WeakPtr<StoragePartitionImpl> storage_partition;
+  base::flat_set<std::string> ephemeral_storage_domains;
+  std::vector<url::Origin> opaque_origins;
+  base::OneShotTimer timer;
+};
+
+using PendingStorageCleanupMap =
+    std::map<StoragePartition*, std::unique_ptr<PendingStorageCleanup>>;
+
+PendingStorageCleanupMap& pending_storage_cleanups() {
+  static base::NoDestructor<PendingStorageCleanupMap> pending_cleanups;
+  return *pending_cleanups.get();
+}
+
+void RunStorageCleanup(StoragePartition* storage_partition) {
+  auto it = pending_storage_cleanups().find(storage_partition);
+  if (it == pending_storage_cleanups().end())
+    return;
+  std::unique_ptr<PendingStorageCleanup> cleanup = std::move(it->second);
+  pending_storage_cleanups().erase(it);
+
+  // The partition is gone together with its ephemeral storage.
+  if (!cleanup->storage_partition)
+    return;
+
+  std::vector<std::string> ephemeral_storage_domains =
+      std::move(cleanup->ephemeral_storage_domains).extract();
+  auto filter = network::mojom::CookieDeletionFilter::New();
+  filter->ephemeral_storage_domains = ephemeral_storage_domains;
+  storage_partition->GetCookieManagerForBrowserProcess()->DeleteCookies(
+      std::move(filter),
+      base::BindOnce(&OnCookiesDeleted, std::move(ephemeral_storage_domains)));
+  for (const auto& opaque_origin : cleanup->opaque_origins) {
+    storage_partition->GetDOMStorageContext()->DeleteLocalStorage(
+        blink::StorageKey(opaque_origin),
+        base::BindOnce(&OnLocalStorageDeleted, opaque_origin));
+  }
+}
+
+void ScheduleStorageCleanup(StoragePartition* storage_partition,
+                            const std::string& ephemeral_storage_domain,
+                            std::vector<url::Origin> opaque_origins) {
+  auto& cleanup = pending_storage_cleanups()[storage_partition];
+  // A partition may have been destroyed and another one created at the same
+  // address while its cleanup was pending.
+  if (cleanup && !cleanup->storage_partition)
+    cleanup.reset();
+  if (!cleanup) {
+    cleanup = std::make_unique<PendingStorageCleanup>();
+    cleanup->storage_partition =
+        static_cast<StoragePartitionImpl*>(storage_partition)->GetWeakPtr();
+    cleanup->timer.Start(
+        FROM_HERE,
+        g_storage_cleanup_delay_for_testing.is_min()
+            ? kStorageCleanupDelay
+            : g_storage_cleanup_delay_for_testing,
+        base::BindOnce(&RunStorageCleanup, storage_partition));
+  }
+
+  cleanup->ephemeral_storage_domains.insert(ephemeral_storage_domain);
+  cleanup->opaque_origins.insert(
+      cleanup->opaque_origins.end(),
+      std::make_move_iterator(opaque_origins.begin()),
+      std::make_move_iterator(opaque_origins.end()));
+}
+
 }  // namespace
 
 TLDEphemeralLifetime::TLDEphemeralLifetime(const TLDEphemeralLifetimeKey& key,
@@ -41,18 +146,20 @@ TLDEphemeralLifetime::TLDEphemeralLifetime(const TLDEphemeralLifetimeKey& key,
   DCHECK(storage_partition_);
   DCHECK(delegate_);
   active_tld_storage_areas().emplace(key_, weak_factory_.GetWeakPtr());
+
+  // Storage of a previous lifetime of this domain must be gone before it is
+  // used again.
+  auto it = pending_storage_cleanups().find(storage_partition_);
+  if (it != pending_storage_cleanups().end() &&
+      it->second->ephemeral_storage_domains.contains(key_.second)) {
+    RunStorageCleanup(storage_partition_);
+  }
 }
 
 TLDEphemeralLifetime::~TLDEphemeralLifetime() {
-  auto filter = network::mojom::CookieDeletionFilter::New();
-  filter->ephemeral_storage_domain = key_.second;
-  storage_partition_->GetCookieManagerForBrowserProcess()->DeleteCookies(
-      std::move(filter), base::NullCallback());
-  for (const auto& opaque_origin :
-       delegate_->TakeEphemeralStorageOpaqueOrigins(key_.second)) {
-    storage_partition_->GetDOMStorageContext()->DeleteLocalStorage(
-        blink::StorageKey(opaque_origin), base::DoNothing());
-  }
+  ScheduleStorageCleanup(
+      storage_partition_, key_.second,
+      delegate_->TakeEphemeralStorageOpaqueOrigins(key_.second));
 
   if (!on_destroy_callbacks_.empty()) {
     auto on_destroy_callbacks = std::move(on_destroy_callbacks_);
@@ -95,6 +202,30 @@ TLDEphemeralLifetime* TLDEphemeralLifetime::Get(
   return it != active_tld_storage_areas().end() ? it->second.get() : nullptr;
 }
 
+// static
+void TLDEphemeralLifetime::SetStorageCleanupDelayForTesting(
+    const base::TimeDelta& time) {
+  g_storage_cleanup_delay_for_testing = time;
+}
+
+// static
+void TLDEphemeralLifetime::RunPendingStorageCleanupsForTesting() {
+  while (!pending_storage_cleanups().empty())
+    RunStorageCleanup(pending_storage_cleanups().begin()->first);
+}
+
+// static
+void TLDEphemeralLifetime::SetOnCookiesDeletedCallbackForTesting(
+    OnCookiesDeletedCallback callback) {
+  cookies_deleted_callback_for_testing() = std::move(callback);
+}
+
+// static
+void TLDEphemeralLifetime::SetOnLocalStorageDeletedCallbackForTesting(
+    OnLocalStorageDeletedCallback callback) {
+  local_storage_deleted_callback_for_testing() = std::move(callback);
+}
+
 void TLDEphemeralLifetime::RegisterOnDestroyCallback(
     OnDestroyCallback callback) {
   on_destroy_callbacks_.push_back(std::move(callback));
@@ -6,6 +6,8 @@
 #ifndef BRAVE_CHROMIUM_SRC_CONTENT_PUBLIC_BROWSER_TLD_EPHEMERAL_LIFETIME_H_
 #define BRAVE_CHROMIUM_SRC_CONTENT_PUBLIC_BROWSER_TLD_EPHEMERAL_LIFETIME_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +17,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "url/origin.h"
 
@@ -43,6 +46,11 @@ class CONTENT_EXPORT TLDEphemeralLifetime
     : public base::RefCounted<TLDEphemeralLifetime> {
  public:
   using OnDestroyCallback = base::OnceCallback<void(const std::string&)>;
+  using OnCookiesDeletedCallback = base::RepeatingCallback<void(
+      const std::vector<std::string>& ephemeral_storage_domains,
+      uint32_t num_deleted)>;
+  using OnLocalStorageDeletedCallback =
+      base::RepeatingCallback<void(const url::Origin& opaque_origin)>;
 
   class Delegate {
    public:
@@ -66,6 +74,19 @@ class CONTENT_EXPORT TLDEphemeralLifetime
       const std::string& storage_domain,
       std::unique_ptr<Delegate> delegate);
 
+  // Ephemeral storage is cleaned up with a delay, together with the storage
+  // of other lifetimes in the same StoragePartition ending in the meantime.
+  static void SetStorageCleanupDelayForTesting(const base::TimeDelta& time);
+  // Runs all pending cleanups without waiting for their delay.
+  static void RunPendingStorageCleanupsForTesting();
+  // |callback| is run when a DeleteCookies request of a cleanup completes.
+  static void SetOnCookiesDeletedCallbackForTesting(
+      OnCookiesDeletedCallback callback);
+  // |callback| is run when a DeleteLocalStorage request of a cleanup
+  // completes.
+  static void SetOnLocalStorageDeletedCallbackForTesting(
+      OnLocalStorageDeletedCallback callback);
+
   // Add a callback to a callback list to be called on destruction.
   void RegisterOnDestroyCallback(OnDestroyCallback callback);
 
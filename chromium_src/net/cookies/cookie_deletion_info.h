@@ -6,8 +6,10 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_DELETION_INFO_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_DELETION_INFO_H_
 
+#include <vector>
+
 #define BRAVE_COOKIE_DELETION_INFO_H \
-  absl::optional<std::string> ephemeral_storage_domain;
+  absl::optional<std::vector<std::string>> ephemeral_storage_domains;
 
 #include "src/net/cookies/cookie_deletion_info.h"
 
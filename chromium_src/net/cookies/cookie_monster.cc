@@ -71,8 +71,10 @@ void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
 
 void CookieMonster::DeleteAllMatchingInfoAsync(CookieDeletionInfo delete_info,
                                                DeleteCallback callback) {
-  if (delete_info.ephemeral_storage_domain.has_value()) {
-    ephemeral_cookie_stores_.erase(*delete_info.ephemeral_storage_domain);
+  if (delete_info.ephemeral_storage_domains.has_value()) {
+    for (const auto& domain : *delete_info.ephemeral_storage_domains) {
+      ephemeral_cookie_stores_.erase(domain);
+    }
     std::move(callback).Run(0);
     return;
   }
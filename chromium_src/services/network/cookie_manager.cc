@@ -5,8 +5,8 @@
 
 #include "services/network/restricted_cookie_manager.h"
 
-#define BRAVE_DELETIONFILTERTOINFO       \
-  delete_info.ephemeral_storage_domain = \
-      std::move(filter->ephemeral_storage_domain);
+#define BRAVE_DELETIONFILTERTOINFO        \
+  delete_info.ephemeral_storage_domains = \
+      std::move(filter->ephemeral_storage_domains);
 
 #include "src/services/network/cookie_manager.cc"
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/auto_reset.h"
 #include "base/base64.h"
 #include "base/base_switches.h"
 #include "base/bind.h"
@@ -128,6 +129,37 @@ constexpr char kNotificationAdUrlPrefix[] = "https://www.brave.com/ads/?";
 
 const base::Feature kServing{"AdServing", base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Prefs read by the ads library, which are mirrored in the utility process.
+const char* const kMirroredPrefs[] = {
+    ads::prefs::kEnabled,
+    ads::prefs::kShouldAllowConversionTracking,
+    ads::prefs::kAdsPerHour,
+    ads::prefs::kIdleTimeThreshold,
+    ads::prefs::kShouldAllowAdsSubdivisionTargeting,
+    ads::prefs::kAdsSubdivisionTargetingCode,
+    ads::prefs::kAutoDetectedAdsSubdivisionTargetingCode,
+    ads::prefs::kCatalogId,
+    ads::prefs::kCatalogVersion,
+    ads::prefs::kCatalogPing,
+    ads::prefs::kCatalogLastUpdated,
+    ads::prefs::kIssuerPing,
+    ads::prefs::kEpsilonGreedyBanditArms,
+    ads::prefs::kEpsilonGreedyBanditEligibleSegments,
+    ads::prefs::kNextTokenRedemptionAt,
+    ads::prefs::kHasMigratedConversionState,
+    ads::prefs::kHasMigratedRewardsState,
+    ads::prefs::kConfirmationsHash,
+    ads::prefs::kClientHash};
+
+bat_ads::mojom::MirroredPrefPtr GetMirroredPref(PrefService* prefs,
+                                                const std::string& path) {
+  const PrefService::Preference* pref = prefs->FindPreference(path);
+  DCHECK(pref) << path << " is not registered";
+
+  return bat_ads::mojom::MirroredPref::New(path, pref->GetValue()->Clone(),
+                                           !pref->IsDefaultValue());
+}
+
 int GetDataResourceId(const std::string& name) {
   if (name == ads::g_catalog_json_schema_data_resource_name) {
     return IDR_ADS_CATALOG_SCHEMA;
@@ -551,6 +583,8 @@ void AdsServiceImpl::Shutdown() {
 
   BackgroundHelper::GetInstance()->RemoveObserver(this);
 
+  FrequencyCappingHelper::GetInstance()->RemoveObserver(this);
+
   g_brave_browser_process->resource_component()->RemoveObserver(this);
 
   url_loaders_.clear();
@@ -566,6 +600,14 @@ void AdsServiceImpl::Shutdown() {
   VLOG_IF(1, !success) << "Failed to release database";
 }
 
+void AdsServiceImpl::SetBatAdsServiceForTesting(
+    mojo::PendingRemote<bat_ads::mojom::BatAdsService> bat_ads_service) {
+  DCHECK(!connected());
+
+  bat_ads_service_.reset();
+  bat_ads_service_.Bind(std::move(bat_ads_service));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool MigrateConfirmationsStateOnFileTaskRunner(const base::FilePath& path) {
@@ -659,6 +701,13 @@ void AdsServiceImpl::Initialize() {
       base::BindRepeating(&AdsServiceImpl::OnPrefsChanged,
                           base::Unretained(this)));
 
+  mirrored_pref_change_registrar_.Init(profile_->GetPrefs());
+  for (const char* path : kMirroredPrefs) {
+    mirrored_pref_change_registrar_.Add(
+        path, base::BindRepeating(&AdsServiceImpl::OnMirroredPrefChanged,
+                                  base::Unretained(this)));
+  }
+
   MaybeStart(false);
 }
 
@@ -803,6 +852,8 @@ void AdsServiceImpl::ResetState() {
   VLOG(1) << "Resetting ads state";
 
   profile_->GetPrefs()->ClearPrefsWithPrefixSilently("brave.brave_ads");
+  // Clearing silently does not notify |mirrored_pref_change_registrar_|.
+  SetMirroredPrefs();
 
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
@@ -926,6 +977,8 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const uint32_t number_of_start,
 
   BackgroundHelper::GetInstance()->AddObserver(this);
 
+  FrequencyCappingHelper::GetInstance()->AddObserver(this);
+
   g_brave_browser_process->resource_component()->AddObserver(this);
 
   if (database_) {
@@ -952,6 +1005,8 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const uint32_t number_of_start,
       bat_ads_.BindNewEndpointAndPassReceiver(),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
+  SetMirroredPrefs();
+
   const std::string locale = GetLocale();
   RegisterResourceComponentsForLocale(locale);
 
@@ -960,6 +1015,29 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const uint32_t number_of_start,
   MaybeShowMyFirstNotificationAd();
 }
 
+void AdsServiceImpl::SetMirroredPrefs() {
+  if (!connected()) {
+    return;
+  }
+
+  std::vector<bat_ads::mojom::MirroredPrefPtr> prefs;
+  for (const char* path : kMirroredPrefs) {
+    prefs.push_back(GetMirroredPref(profile_->GetPrefs(), path));
+  }
+
+  bat_ads_->SetMirroredPrefs(std::move(prefs));
+}
+
+void AdsServiceImpl::OnMirroredPrefChanged(const std::string& path) {
+  if (!connected()) {
+    return;
+  }
+
+  std::vector<bat_ads::mojom::MirroredPrefPtr> prefs;
+  prefs.push_back(GetMirroredPref(profile_->GetPrefs(), path));
+  bat_ads_->SetMirroredPrefs(std::move(prefs));
+}
+
 void AdsServiceImpl::SetEnvironment() {
   ads::mojom::Environment environment;
 
@@ -2175,6 +2253,7 @@ void AdsServiceImpl::RecordAdEventForId(const std::string& id,
                                         const std::string& ad_type,
                                         const std::string& confirmation_type,
                                         const base::Time time) const {
+  base::AutoReset<bool> auto_reset(&is_changing_ad_events_, true);
   FrequencyCappingHelper::GetInstance()->RecordAdEventForId(
       id, ad_type, confirmation_type, time);
 }
@@ -2187,6 +2266,7 @@ std::vector<base::Time> AdsServiceImpl::GetAdEvents(
 }
 
 void AdsServiceImpl::ResetAdEventsForId(const std::string& id) const {
+  base::AutoReset<bool> auto_reset(&is_changing_ad_events_, true);
   return FrequencyCappingHelper::GetInstance()->ResetAdEventsForId(id);
 }
 
@@ -2555,4 +2635,14 @@ void AdsServiceImpl::OnBrowserDidEnterBackground() {
   bat_ads_->OnBrowserDidEnterBackground();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+void AdsServiceImpl::OnAdEventsChanged() {
+  if (is_changing_ad_events_ || !connected()) {
+    return;
+  }
+
+  bat_ads_->OnAdEventsChanged();
+}
+
 }  // namespace brave_ads
@@ -27,6 +27,7 @@
 #include "brave/components/brave_adaptive_captcha/buildflags/buildflags.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/component_updater/resource_component.h"
+#include "brave/components/brave_ads/browser/frequency_capping_helper.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "chrome/browser/notifications/notification_handler.h"
 #include "components/history/core/browser/history_service_observer.h"
@@ -76,6 +77,7 @@ class AdsServiceImpl : public AdsService,
                        public ads::AdsClient,
                        public history::HistoryServiceObserver,
                        BackgroundHelper::Observer,
+                       public FrequencyCappingHelper::Observer,
                        public brave_ads::Observer,
                        public base::SupportsWeakPtr<AdsServiceImpl> {
  public:
@@ -220,6 +222,11 @@ class AdsServiceImpl : public AdsService,
   // KeyedService implementation
   void Shutdown() override;
 
+  // Binds the ads library service to |bat_ads_service| instead of launching
+  // the utility process. Must be called before ads are started.
+  void SetBatAdsServiceForTesting(
+      mojo::PendingRemote<bat_ads::mojom::BatAdsService> bat_ads_service);
+
  private:
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
@@ -254,6 +261,9 @@ class AdsServiceImpl : public AdsService,
   void OnEnsureBaseDirectoryExists(const uint32_t number_of_start,
                                    const bool success);
 
+  void SetMirroredPrefs();
+  void OnMirroredPrefChanged(const std::string& path);
+
   void SetEnvironment();
   void SetDebug();
   void ParseCommandLineSwitches();
@@ -480,6 +490,9 @@ class AdsServiceImpl : public AdsService,
   void OnBrowserDidEnterForeground() override;
   void OnBrowserDidEnterBackground() override;
 
+  // FrequencyCappingHelper::Observer implementation
+  void OnAdEventsChanged() override;
+
   raw_ptr<Profile> profile_ = nullptr;  // NOT OWNED
 
   raw_ptr<history::HistoryService> history_service_ = nullptr;  // NOT OWNED
@@ -524,6 +537,12 @@ class AdsServiceImpl : public AdsService,
   base::RepeatingTimer idle_poll_timer_;
 
   PrefChangeRegistrar profile_pref_change_registrar_;
+  // Observes the prefs read by the ads library, see SetMirroredPrefs.
+  PrefChangeRegistrar mirrored_pref_change_registrar_;
+
+  // True while this instance records or resets ad events, which the ads
+  // library already knows about.
+  mutable bool is_changing_ad_events_ = false;
 
   SimpleURLLoaderList url_loaders_;
 
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_ads/browser/frequency_capping_helper.h"
 
+#include "base/check.h"
 #include "base/time/time.h"
 
 namespace brave_ads {
@@ -17,12 +18,26 @@ FrequencyCappingHelper* FrequencyCappingHelper::GetInstance() {
   return base::Singleton<FrequencyCappingHelper>::get();
 }
 
+void FrequencyCappingHelper::AddObserver(Observer* observer) {
+  DCHECK(observer);
+  observers_.AddObserver(observer);
+}
+
+void FrequencyCappingHelper::RemoveObserver(Observer* observer) {
+  DCHECK(observer);
+  observers_.RemoveObserver(observer);
+}
+
 void FrequencyCappingHelper::RecordAdEventForId(
     const std::string& id,
     const std::string& ad_type,
     const std::string& confirmation_type,
     const base::Time time) {
   history_.RecordForId(id, ad_type, confirmation_type, time);
+
+  for (auto& observer : observers_) {
+    observer.OnAdEventsChanged();
+  }
 }
 
 std::vector<base::Time> FrequencyCappingHelper::GetAdEvents(
@@ -33,6 +48,10 @@ std::vector<base::Time> FrequencyCappingHelper::GetAdEvents(
 
 void FrequencyCappingHelper::ResetAdEventsForId(const std::string& id) {
   history_.ResetForId(id);
+
+  for (auto& observer : observers_) {
+    observer.OnAdEventsChanged();
+  }
 }
 
 }  // namespace brave_ads
@@ -10,6 +10,8 @@
 #include <vector>
 
 #include "base/memory/singleton.h"
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
 #include "bat/ads/ad_event_history.h"
 
 namespace base {
@@ -20,8 +22,20 @@ namespace brave_ads {
 
 class FrequencyCappingHelper {
  public:
+  class Observer : public base::CheckedObserver {
+   public:
+    // Invoked when ad events were recorded or reset.
+    virtual void OnAdEventsChanged() = 0;
+
+   protected:
+    ~Observer() override = default;
+  };
+
   static FrequencyCappingHelper* GetInstance();
 
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
   void RecordAdEventForId(const std::string& id,
                           const std::string& ad_type,
                           const std::string& confirmation_type,
@@ -41,6 +55,8 @@ class FrequencyCappingHelper {
 
   ads::AdEventHistory history_;
 
+  base::ObserverList<Observer> observers_;
+
   FrequencyCappingHelper(const FrequencyCappingHelper&) = delete;
   FrequencyCappingHelper& operator=(const FrequencyCappingHelper&) = delete;
 };
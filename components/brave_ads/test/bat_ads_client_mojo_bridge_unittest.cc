@@ -0,0 +1,261 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/json/values_util.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/pref_names.h"
+#include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAds*
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace bat_ads {
+
+namespace {
+
+constexpr char kAdType[] = "ad_notification";
+constexpr char kServedConfirmationType[] = "served";
+constexpr char kViewedConfirmationType[] = "view";
+
+mojom::MirroredPrefPtr CreateMirroredPref(const std::string& path,
+                                          base::Value value) {
+  return mojom::MirroredPref::New(path, std::move(value),
+                                  /* has_pref_path */ true);
+}
+
+}  // namespace
+
+class BatAdsClientMojoBridgeTest : public testing::Test {
+ public:
+  BatAdsClientMojoBridgeTest()
+      : ads_client_mojo_bridge_(&ads_client_mock_),
+        receiver_(&ads_client_mojo_bridge_) {
+    bat_ads_client_mojo_bridge_ = std::make_unique<BatAdsClientMojoBridge>(
+        receiver_.BindNewEndpointAndPassDedicatedRemote());
+  }
+
+  ~BatAdsClientMojoBridgeTest() override = default;
+
+ protected:
+  void SetMirroredPrefs() {
+    std::vector<mojom::MirroredPrefPtr> prefs;
+    prefs.push_back(
+        CreateMirroredPref(ads::prefs::kEnabled, base::Value(true)));
+    prefs.push_back(
+        CreateMirroredPref(ads::prefs::kAdsPerHour, base::Value("5")));
+    prefs.push_back(
+        CreateMirroredPref(ads::prefs::kIdleTimeThreshold, base::Value(15)));
+    prefs.push_back(
+        CreateMirroredPref(ads::prefs::kCatalogId, base::Value("catalog")));
+    prefs.push_back(
+        CreateMirroredPref(ads::prefs::kCatalogLastUpdated,
+                           base::TimeToValue(base::Time::FromDoubleT(1))));
+    prefs.push_back(CreateMirroredPref(ads::prefs::kEpsilonGreedyBanditArms,
+                                       base::Value("{}")));
+    bat_ads_client_mojo_bridge_->SetMirroredPrefs(std::move(prefs));
+  }
+
+  // Replays a fixed list of the reads the ads library makes when serving a
+  // notification ad, then records a served ad event. This does not run the
+  // real serving code, so call counts only show which of these reads reach
+  // the browser.
+  void ReplayServeNotificationAdReads() {
+    ads::AdsClient* ads_client = bat_ads_client_mojo_bridge_.get();
+    EXPECT_TRUE(ads_client->GetBooleanPref(ads::prefs::kEnabled));
+    ads_client->GetInt64Pref(ads::prefs::kAdsPerHour);
+    ads_client->GetIntegerPref(ads::prefs::kIdleTimeThreshold);
+    ads_client->HasPrefPath(ads::prefs::kCatalogId);
+    ads_client->GetStringPref(ads::prefs::kCatalogId);
+    ads_client->GetTimePref(ads::prefs::kCatalogLastUpdated);
+    ads_client->GetStringPref(ads::prefs::kEpsilonGreedyBanditArms);
+    EXPECT_TRUE(ads_client->IsBrowserActive());
+    ads_client->GetAdEvents(kAdType, kServedConfirmationType);
+    ads_client->GetAdEvents(kAdType, kViewedConfirmationType);
+    ads_client->RecordAdEventForId("id", kAdType, kServedConfirmationType,
+                                   base::Time::Now());
+    task_environment_.RunUntilIdle();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+
+  NiceMock<ads::AdsClientMock> ads_client_mock_;
+  AdsClientMojoBridge ads_client_mojo_bridge_;
+  mojo::AssociatedReceiver<mojom::BatAdsClient> receiver_;
+  std::unique_ptr<BatAdsClientMojoBridge> bat_ads_client_mojo_bridge_;
+};
+
+TEST_F(BatAdsClientMojoBridgeTest, ReplayedReadsWithoutMirroredPrefs) {
+  constexpr int kAdsCount = 10;
+
+  ON_CALL(ads_client_mock_, GetBooleanPref(_)).WillByDefault(Return(true));
+  ON_CALL(ads_client_mock_, IsBrowserActive()).WillByDefault(Return(true));
+
+  // Every pref read is a sync call to the browser.
+  EXPECT_CALL(ads_client_mock_, GetBooleanPref(_)).Times(kAdsCount);
+  EXPECT_CALL(ads_client_mock_, GetInt64Pref(_)).Times(kAdsCount);
+  EXPECT_CALL(ads_client_mock_, GetIntegerPref(_)).Times(kAdsCount);
+  EXPECT_CALL(ads_client_mock_, HasPrefPath(_)).Times(kAdsCount);
+  EXPECT_CALL(ads_client_mock_, GetStringPref(_)).Times(2 * kAdsCount);
+  EXPECT_CALL(ads_client_mock_, GetTimePref(_)).Times(kAdsCount);
+  EXPECT_CALL(ads_client_mock_, IsBrowserActive()).Times(1);
+  EXPECT_CALL(ads_client_mock_, GetAdEvents(_, _)).Times(1 + kAdsCount);
+  EXPECT_CALL(ads_client_mock_, RecordAdEventForId(_, _, _, _))
+      .Times(kAdsCount);
+
+  for (int i = 0; i < kAdsCount; ++i) {
+    ReplayServeNotificationAdReads();
+  }
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ReplayedReadsWithMirroredPrefs) {
+  constexpr int kAdsCount = 10;
+
+  SetMirroredPrefs();
+  ON_CALL(ads_client_mock_, IsBrowserActive()).WillByDefault(Return(true));
+
+  // Only ad events which were recorded since they were read need a sync call.
+  EXPECT_CALL(ads_client_mock_, GetBooleanPref(_)).Times(0);
+  EXPECT_CALL(ads_client_mock_, GetInt64Pref(_)).Times(0);
+  EXPECT_CALL(ads_client_mock_, GetIntegerPref(_)).Times(0);
+  EXPECT_CALL(ads_client_mock_, HasPrefPath(_)).Times(0);
+  EXPECT_CALL(ads_client_mock_, GetStringPref(_)).Times(0);
+  EXPECT_CALL(ads_client_mock_, GetTimePref(_)).Times(0);
+  EXPECT_CALL(ads_client_mock_, IsBrowserActive()).Times(1);
+  EXPECT_CALL(ads_client_mock_,
+              GetAdEvents(kAdType, kServedConfirmationType))
+      .Times(kAdsCount);
+  EXPECT_CALL(ads_client_mock_,
+              GetAdEvents(kAdType, kViewedConfirmationType))
+      .Times(1);
+  EXPECT_CALL(ads_client_mock_, RecordAdEventForId(_, _, _, _))
+      .Times(kAdsCount);
+
+  for (int i = 0; i < kAdsCount; ++i) {
+    ReplayServeNotificationAdReads();
+  }
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, MirroredPrefValues) {
+  SetMirroredPrefs();
+
+  EXPECT_TRUE(
+      bat_ads_client_mojo_bridge_->GetBooleanPref(ads::prefs::kEnabled));
+  EXPECT_EQ(5, bat_ads_client_mojo_bridge_->GetInt64Pref(
+                   ads::prefs::kAdsPerHour));
+  EXPECT_EQ(15, bat_ads_client_mojo_bridge_->GetIntegerPref(
+                    ads::prefs::kIdleTimeThreshold));
+  EXPECT_EQ("catalog",
+            bat_ads_client_mojo_bridge_->GetStringPref(ads::prefs::kCatalogId));
+  EXPECT_EQ(base::Time::FromDoubleT(1),
+            bat_ads_client_mojo_bridge_->GetTimePref(
+                ads::prefs::kCatalogLastUpdated));
+  EXPECT_TRUE(
+      bat_ads_client_mojo_bridge_->HasPrefPath(ads::prefs::kCatalogId));
+
+  // Setters update the mirrored value without waiting for the browser.
+  bat_ads_client_mojo_bridge_->SetInt64Pref(ads::prefs::kAdsPerHour, 2);
+  EXPECT_EQ(2, bat_ads_client_mojo_bridge_->GetInt64Pref(
+                   ads::prefs::kAdsPerHour));
+
+  const base::Time time = base::Time::Now();
+  bat_ads_client_mojo_bridge_->SetTimePref(ads::prefs::kCatalogLastUpdated,
+                                           time);
+  EXPECT_EQ(time, bat_ads_client_mojo_bridge_->GetTimePref(
+                      ads::prefs::kCatalogLastUpdated));
+
+  EXPECT_CALL(ads_client_mock_, SetInt64Pref(ads::prefs::kAdsPerHour, 2));
+  EXPECT_CALL(ads_client_mock_,
+              SetTimePref(ads::prefs::kCatalogLastUpdated, time));
+  task_environment_.RunUntilIdle();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, KeepMirroredValueUntilWriteIsAcknowledged) {
+  SetMirroredPrefs();
+
+  bat_ads_client_mojo_bridge_->SetBooleanPref(ads::prefs::kEnabled, false);
+
+  // The browser sent the old value before it received the new one.
+  std::vector<mojom::MirroredPrefPtr> prefs;
+  prefs.push_back(CreateMirroredPref(ads::prefs::kEnabled, base::Value(true)));
+  bat_ads_client_mojo_bridge_->SetMirroredPrefs(std::move(prefs));
+  EXPECT_FALSE(
+      bat_ads_client_mojo_bridge_->GetBooleanPref(ads::prefs::kEnabled));
+
+  EXPECT_CALL(ads_client_mock_, SetBooleanPref(ads::prefs::kEnabled, false));
+  task_environment_.RunUntilIdle();
+
+  // The pref changed in the browser after the write.
+  prefs.clear();
+  prefs.push_back(CreateMirroredPref(ads::prefs::kEnabled, base::Value(true)));
+  bat_ads_client_mojo_bridge_->SetMirroredPrefs(std::move(prefs));
+  EXPECT_TRUE(
+      bat_ads_client_mojo_bridge_->GetBooleanPref(ads::prefs::kEnabled));
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ClearedPrefIsReadFromBrowser) {
+  SetMirroredPrefs();
+
+  bat_ads_client_mojo_bridge_->ClearPref(ads::prefs::kCatalogId);
+
+  EXPECT_CALL(ads_client_mock_, ClearPref(ads::prefs::kCatalogId));
+  EXPECT_CALL(ads_client_mock_, HasPrefPath(ads::prefs::kCatalogId))
+      .WillOnce(Return(false));
+  EXPECT_CALL(ads_client_mock_, GetStringPref(ads::prefs::kCatalogId))
+      .WillOnce(Return(""));
+  EXPECT_FALSE(
+      bat_ads_client_mojo_bridge_->HasPrefPath(ads::prefs::kCatalogId));
+  EXPECT_EQ("",
+            bat_ads_client_mojo_bridge_->GetStringPref(ads::prefs::kCatalogId));
+  task_environment_.RunUntilIdle();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, BrowserActiveState) {
+  EXPECT_CALL(ads_client_mock_, IsBrowserActive()).WillOnce(Return(true));
+  EXPECT_TRUE(bat_ads_client_mojo_bridge_->IsBrowserActive());
+  EXPECT_TRUE(bat_ads_client_mojo_bridge_->IsBrowserActive());
+
+  bat_ads_client_mojo_bridge_->SetBrowserIsActive(false);
+  EXPECT_FALSE(bat_ads_client_mojo_bridge_->IsBrowserActive());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ReadAdEventsAgainWhenChanged) {
+  const std::vector<base::Time> ad_events = {base::Time::Now()};
+
+  EXPECT_CALL(ads_client_mock_, GetAdEvents(kAdType, kViewedConfirmationType))
+      .Times(3)
+      .WillRepeatedly(Return(ad_events));
+  EXPECT_EQ(ad_events, bat_ads_client_mojo_bridge_->GetAdEvents(
+                           kAdType, kViewedConfirmationType));
+  EXPECT_EQ(ad_events, bat_ads_client_mojo_bridge_->GetAdEvents(
+                           kAdType, kViewedConfirmationType));
+
+  // Another ads instance changed the ad events.
+  bat_ads_client_mojo_bridge_->OnAdEventsChanged();
+  EXPECT_EQ(ad_events, bat_ads_client_mojo_bridge_->GetAdEvents(
+                           kAdType, kViewedConfirmationType));
+
+  bat_ads_client_mojo_bridge_->ResetAdEventsForId("id");
+  EXPECT_EQ(ad_events, bat_ads_client_mojo_bridge_->GetAdEvents(
+                           kAdType, kViewedConfirmationType));
+  task_environment_.RunUntilIdle();
+}
+
+}  // namespace bat_ads
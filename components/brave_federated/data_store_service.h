@@ -8,6 +8,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
@@ -49,6 +50,11 @@ class AsyncDataStore {
     data_store_.AsyncCall(&T::AddLog).WithArgs(log).Then(std::move(callback));
   }
 
+  void AddLogs(const std::vector<U>& logs,
+               base::OnceCallback<void(bool)> callback) {
+    data_store_.AsyncCall(&T::AddLogs).WithArgs(logs).Then(std::move(callback));
+  }
+
   void LoadLogs(base::OnceCallback<void(base::flat_map<int, U>)> callback) {
     data_store_.AsyncCall(&T::LoadLogs).Then(std::move(callback));
   }
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/sequence_checker.h"
@@ -81,7 +82,29 @@ bool AdNotificationTimingDataStore::AddLog(
     const AdNotificationTimingTaskLog& log) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  sql::Statement s(db_.GetUniqueStatement(
+  return InsertLog(log);
+}
+
+bool AdNotificationTimingDataStore::AddLogs(
+    const std::vector<AdNotificationTimingTaskLog>& logs) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Transaction transaction(&db_);
+  if (!transaction.Begin())
+    return false;
+
+  for (const auto& log : logs) {
+    if (!InsertLog(log))
+      return false;
+  }
+
+  return transaction.Commit();
+}
+
+bool AdNotificationTimingDataStore::InsertLog(
+    const AdNotificationTimingTaskLog& log) {
+  sql::Statement s(db_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf(
           "INSERT INTO %s (time, locale, number_of_tabs, label, creation_date) "
           "VALUES (?,?,?,?,?)",
@@ -97,7 +120,8 @@ AdNotificationTimingDataStore::LoadLogs() {
 
   AdNotificationTimingDataStore::IdToAdNotificationTimingTaskLogMap
       notification_timing_logs;
-  sql::Statement s(db_.GetUniqueStatement(
+  sql::Statement s(db_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf("SELECT id, time, locale, number_of_tabs, label, "
                          "creation_date FROM %s",
                          task_name_.c_str())
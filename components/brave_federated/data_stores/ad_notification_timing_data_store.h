@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_AD_NOTIFICATION_TIMING_DATA_STORE_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
@@ -67,10 +68,13 @@ class AdNotificationTimingDataStore final : public DataStore {
   using DataStore::DeleteLogs;
 
   bool AddLog(const AdNotificationTimingTaskLog& log);
+  // Adds |logs| in a single transaction, either all of them or none.
+  bool AddLogs(const std::vector<AdNotificationTimingTaskLog>& logs);
   IdToAdNotificationTimingTaskLogMap LoadLogs();
   bool EnsureTable() override;
 
  private:
+  bool InsertLog(const AdNotificationTimingTaskLog& log);
   void AddLogsForTesting();
   SEQUENCE_CHECKER(sequence_checker_);
 };
@@ -6,6 +6,7 @@
 #include "brave/components/brave_federated/data_stores/ad_notification_timing_data_store.h"
 
 #include <string>
+#include <vector>
 
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
@@ -126,6 +127,15 @@ TEST_F(AdNotificationTimingDataStoreTest, AddLog) {
   EXPECT_EQ(2U, CountRecords());
 }
 
+TEST_F(AdNotificationTimingDataStoreTest, AddLogs) {
+  ClearDB();
+  std::vector<AdNotificationTimingTaskLog> logs;
+  for (const auto& info : ad_notification_task_log_test_db)
+    logs.push_back(AdNotificationTimingTaskLogFromTestInfo(info));
+  EXPECT_TRUE(ad_notification_data_store_->AddLogs(logs));
+  EXPECT_EQ(std::size(ad_notification_task_log_test_db), CountRecords());
+}
+
 TEST_F(AdNotificationTimingDataStoreTest, LoadLogs) {
   AddAll();
   EXPECT_EQ(4U, CountRecords());
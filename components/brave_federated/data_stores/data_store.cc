@@ -44,6 +44,9 @@ void DatabaseErrorCallback(sql::Database* db,
     DLOG(FATAL) << db->GetErrorMessage();
 }
 
+// Value of PRAGMA auto_vacuum for incremental vacuum.
+constexpr int kAutoVacuumIncremental = 2;
+
 }  // namespace
 
 namespace brave_federated {
@@ -70,7 +73,12 @@ bool DataStore::Init(int task_id,
       base::BindRepeating(&DatabaseErrorCallback, &db_, database_path_));
 
   // Attach the database to our index file.
-  return db_.Open(database_path_) && EnsureTable();
+  if (!db_.Open(database_path_))
+    return false;
+
+  // Logs are still usable if the file can not shrink.
+  std::ignore = EnsureIncrementalVacuum();
+  return EnsureTable();
 }
 
 DataStore::~DataStore() {}
@@ -78,18 +86,21 @@ DataStore::~DataStore() {}
 bool DataStore::DeleteLogs() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  if (!db_.Execute(
-          base::StringPrintf("DELETE FROM %s", task_name_.c_str()).c_str()))
+  sql::Statement s(db_.GetCachedStatement(
+      SQL_FROM_HERE,
+      base::StringPrintf("DELETE FROM %s", task_name_.c_str()).c_str()));
+  if (!s.Run())
     return false;
 
-  std::ignore = db_.Execute("VACUUM");
+  IncrementalVacuum();
   return true;
 }
 
 void DataStore::EnforceRetentionPolicy() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  sql::Statement s(db_.GetUniqueStatement(
+  sql::Statement s(db_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf(" DELETE FROM %s WHERE creation_date < ? OR id NOT IN "
                          "(SELECT id FROM %s ORDER BY id DESC LIMIT ?)",
                          task_name_.c_str(), task_name_.c_str())
@@ -98,11 +109,35 @@ void DataStore::EnforceRetentionPolicy() {
       base::Time::Now() - base::Seconds(max_retention_days_ * 24 * 60 * 60);
   s.BindInt64(0, expiration_threshold.ToInternalValue());
   s.BindInt(1, max_number_of_records_);
-  s.Run();
+  if (s.Run() && db_.GetLastChangeCount() > 0)
+    IncrementalVacuum();
 }
 
 bool DataStore::EnsureTable() {
   return false;
 }
 
+bool DataStore::EnsureIncrementalVacuum() {
+  {
+    sql::Statement s(db_.GetUniqueStatement("PRAGMA auto_vacuum"));
+    if (!s.Step())
+      return false;
+    if (s.ColumnInt(0) == kAutoVacuumIncremental)
+      return true;
+  }
+
+  // Changing the mode of an existing database only takes effect after a full
+  // VACUUM, which is needed once.
+  return db_.Execute("PRAGMA auto_vacuum = INCREMENTAL") &&
+         db_.Execute("VACUUM");
+}
+
+void DataStore::IncrementalVacuum() {
+  // Each step frees a page, so run the pragma to completion.
+  sql::Statement s(
+      db_.GetCachedStatement(SQL_FROM_HERE, "PRAGMA incremental_vacuum"));
+  while (s.Step()) {
+  }
+}
+
 }  // namespace brave_federated
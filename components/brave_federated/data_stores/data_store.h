@@ -30,6 +30,7 @@ class DataStore {
             const std::string& task_name,
             int max_number_of_records,
             int max_retention_days);
+  // Deletes all logs and returns the freed pages to the file system.
   bool DeleteLogs();
   void EnforceRetentionPolicy();
 
@@ -51,6 +52,10 @@ class DataStore {
 
  private:
   virtual bool EnsureTable();
+  // Switches the database to incremental vacuum, so deleting logs does not
+  // need a full VACUUM to shrink the file.
+  bool EnsureIncrementalVacuum();
+  void IncrementalVacuum();
 
   SEQUENCE_CHECKER(sequence_checker_);
 };
@@ -4,6 +4,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <string>
+#include <vector>
 
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
@@ -40,6 +41,7 @@ class DataStoreTest : public testing::Test {
 
   void ClearDB();
   size_t CountRecords() const;
+  int GetPragma(const char* pragma) const;
 
   TestTaskLog TestTaskLogFromTestInfo(const TestTaskLogTestInfo& info);
 
@@ -73,6 +75,12 @@ size_t DataStoreTest::CountRecords() const {
   return static_cast<size_t>(s.ColumnInt(0));
 }
 
+int DataStoreTest::GetPragma(const char* pragma) const {
+  sql::Statement s(test_data_store_->db_.GetUniqueStatement(pragma));
+  EXPECT_TRUE(s.Step());
+  return s.ColumnInt(0);
+}
+
 TestTaskLog DataStoreTest::TestTaskLogFromTestInfo(
     const TestTaskLogTestInfo& info) {
   return TestTaskLog(info.id, info.label,
@@ -117,4 +125,41 @@ TEST_F(DataStoreTest, EnforceRetentionPolicy) {
   EXPECT_TRUE(it == test_task_logs.end());
 }
 
+TEST_F(DataStoreTest, UsesIncrementalVacuum) {
+  // 2 stands for INCREMENTAL.
+  EXPECT_EQ(2, GetPragma("PRAGMA auto_vacuum"));
+}
+
+TEST_F(DataStoreTest, AddLogs) {
+  std::vector<TestTaskLog> logs;
+  for (const auto& info : test_task_log_test_db)
+    logs.push_back(TestTaskLogFromTestInfo(info));
+  EXPECT_TRUE(test_data_store_->AddLogs(logs));
+  EXPECT_EQ(std::size(test_task_log_test_db), CountRecords());
+
+  TestDataStore::TestTaskLogMap test_task_logs;
+  test_data_store_->LoadLogs(&test_task_logs);
+  EXPECT_EQ(std::size(test_task_log_test_db), test_task_logs.size());
+}
+
+TEST_F(DataStoreTest, AddAndPruneManyLogs) {
+  constexpr size_t kLogCount = 100000;
+  std::vector<TestTaskLog> logs;
+  for (size_t i = 0; i < kLogCount; ++i)
+    logs.push_back(TestTaskLog(0, i % 2 == 1, base::Time::Now()));
+
+  EXPECT_TRUE(test_data_store_->AddLogs(logs));
+  EXPECT_EQ(kLogCount, CountRecords());
+
+  test_data_store_->EnforceRetentionPolicy();
+  // The data store keeps at most 50 records.
+  EXPECT_EQ(50U, CountRecords());
+  EXPECT_EQ(0, GetPragma("PRAGMA freelist_count"));
+
+  EXPECT_TRUE(test_data_store_->AddLogs(logs));
+  EXPECT_TRUE(test_data_store_->DeleteLogs());
+  EXPECT_EQ(0U, CountRecords());
+  EXPECT_EQ(0, GetPragma("PRAGMA freelist_count"));
+}
+
 }  // namespace brave_federated
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/strings/stringprintf.h"
@@ -57,7 +58,8 @@ bool TestDataStore::Init(const int task_id,
 }
 
 bool TestDataStore::AddLog(const TestTaskLog& log) {
-  sql::Statement s(db_.GetUniqueStatement(
+  sql::Statement s(db_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf("INSERT INTO %s (label, creation_date) "
                          "VALUES (?,?)",
                          task_name_.c_str())
@@ -66,9 +68,23 @@ bool TestDataStore::AddLog(const TestTaskLog& log) {
   return s.Run();
 }
 
+bool TestDataStore::AddLogs(const std::vector<TestTaskLog>& logs) {
+  sql::Transaction transaction(&db_);
+  if (!transaction.Begin())
+    return false;
+
+  for (const auto& log : logs) {
+    if (!AddLog(log))
+      return false;
+  }
+
+  return transaction.Commit();
+}
+
 void TestDataStore::LoadLogs(TestTaskLogMap* test_task_logs) {
   DCHECK(test_task_logs);
-  sql::Statement s(db_.GetUniqueStatement(
+  sql::Statement s(db_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf("SELECT id, label, creation_date FROM %s",
                          task_name_.c_str())
           .c_str()));
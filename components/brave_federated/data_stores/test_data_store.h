@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_TEST_DATA_STORE_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
@@ -46,6 +47,7 @@ class TestDataStore final : public DataStore {
   using DataStore::DeleteLogs;
 
   bool AddLog(const TestTaskLog& log);
+  bool AddLogs(const std::vector<TestTaskLog>& logs);
   void LoadLogs(TestTaskLogMap* test_task_logs);
   bool EnsureTable() override;
 };
@@ -9,8 +9,10 @@
 #include <cmath>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -35,6 +37,18 @@ bool StandardiseFeatsNoOutliers(
   return false;
 }
 
+const base::flat_map<base::StringPiece, size_t>& FeatureIndexByName() {
+  static const base::NoDestructor<base::flat_map<base::StringPiece, size_t>>
+      feature_index_by_name([] {
+        std::vector<std::pair<base::StringPiece, size_t>> entries;
+        entries.reserve(feature_count);
+        for (size_t i = 0; i < feature_count; i++)
+          entries.emplace_back(feature_sequence[i], i);
+        return base::flat_map<base::StringPiece, size_t>(std::move(entries));
+      }());
+  return *feature_index_by_name;
+}
+
 }  // namespace
 
 double LinregPredictVector(const std::array<double, feature_count>& features) {
@@ -75,4 +89,12 @@ double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
   return LinregPredictVector(feature_vector);
 }
 
+absl::optional<size_t> GetFeatureIndex(base::StringPiece feature_name) {
+  const auto& feature_index_by_name = FeatureIndexByName();
+  auto it = feature_index_by_name.find(feature_name);
+  if (it == feature_index_by_name.end())
+    return absl::nullopt;
+  return it->second;
+}
+
 }  // namespace brave_perf_predictor
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -15,6 +16,82 @@
 
 namespace brave_perf_predictor {
 
+namespace {
+
+enum ResourceType {
+  kDocument = 0,
+  kStylesheet,
+  kScript,
+  kImage,
+  kFont,
+  kMedia,
+  kOther,
+  kThirdParty,
+  kTotal,
+  kResourceTypeCount
+};
+
+constexpr const char* kResourceTypeNames[kResourceTypeCount] = {
+    "document", "stylesheet", "script",      "image", "font",
+    "media",    "other",      "third-party", "total"};
+
+// Positions of the features updated while a page loads, looked up by name
+// once instead of on every load event.
+struct FeatureIndices {
+  FeatureIndices()
+      : adblock_requests(GetFeatureIndex("adblockRequests")),
+        first_meaningful_paint(GetFeatureIndex("metrics.firstMeaningfulPaint")),
+        observed_dom_content_loaded(
+            GetFeatureIndex("metrics.observedDomContentLoaded")),
+        observed_first_visual_change(
+            GetFeatureIndex("metrics.observedFirstVisualChange")),
+        observed_load(GetFeatureIndex("metrics.observedLoad")) {
+    for (int type = 0; type < kResourceTypeCount; type++) {
+      const std::string prefix =
+          std::string("resources.") + kResourceTypeNames[type];
+      request_count[type] = GetFeatureIndex(prefix + ".requestCount");
+      size[type] = GetFeatureIndex(prefix + ".size");
+    }
+  }
+
+  absl::optional<size_t> adblock_requests;
+  absl::optional<size_t> first_meaningful_paint;
+  absl::optional<size_t> observed_dom_content_loaded;
+  absl::optional<size_t> observed_first_visual_change;
+  absl::optional<size_t> observed_load;
+  absl::optional<size_t> request_count[kResourceTypeCount];
+  absl::optional<size_t> size[kResourceTypeCount];
+};
+
+const FeatureIndices& GetFeatureIndices() {
+  static const base::NoDestructor<FeatureIndices> feature_indices;
+  return *feature_indices;
+}
+
+ResourceType GetResourceType(network::mojom::RequestDestination destination) {
+  switch (destination) {
+    case network::mojom::RequestDestination::kDocument:
+    case network::mojom::RequestDestination::kIframe:
+      return kDocument;
+    case network::mojom::RequestDestination::kStyle:
+      return kStylesheet;
+    case network::mojom::RequestDestination::kScript:
+      return kScript;
+    case network::mojom::RequestDestination::kImage:
+      return kImage;
+    case network::mojom::RequestDestination::kFont:
+      return kFont;
+    case network::mojom::RequestDestination::kAudio:
+    case network::mojom::RequestDestination::kTrack:
+    case network::mojom::RequestDestination::kVideo:
+      return kMedia;
+    default:
+      return kOther;
+  }
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor(
     const NamedThirdPartyRegistry* registry)
     : tp_registry_(registry) {}
@@ -23,36 +100,45 @@ BandwidthSavingsPredictor::~BandwidthSavingsPredictor() = default;
 
 void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
+  const FeatureIndices& indices = GetFeatureIndices();
+
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
-        timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
+    SetFeature(
+        indices.first_meaningful_paint,
+        timing.paint_timing->first_meaningful_paint.value().InMillisecondsF());
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
-        timing.document_timing->dom_content_loaded_event_start.value()
-            .InMillisecondsF();
+    SetFeature(indices.observed_dom_content_loaded,
+               timing.document_timing->dom_content_loaded_event_start.value()
+                   .InMillisecondsF());
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
-        timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
+    SetFeature(
+        indices.observed_first_visual_change,
+        timing.paint_timing->first_contentful_paint.value().InMillisecondsF());
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
-        timing.document_timing->load_event_start.value().InMillisecondsF();
+    SetFeature(
+        indices.observed_load,
+        timing.document_timing->load_event_start.value().InMillisecondsF());
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
-    const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+    const GURL& resource_url) {
+  AddToFeature(GetFeatureIndices().adblock_requests, 1);
 
-  if (tp_registry_) {
-    const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+  if (!tp_registry_ || !resource_url.has_host())
+    return;
+  const auto third_party_id =
+      tp_registry_->GetThirdPartyIdForHost(resource_url.host_piece());
+  if (third_party_id) {
+    SetFeature(
+        tp_registry_->GetThirdPartyById(*third_party_id).blocked_feature_index,
+        1);
   }
 }
 
@@ -67,53 +153,27 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
   }
   main_frame_url_ = main_frame_url;
 
+  const FeatureIndices& indices = GetFeatureIndices();
+  const double size = resource_load_info.raw_body_bytes;
+
   const bool is_third_party =
       !net::registry_controlled_domains::SameDomainOrHost(
           main_frame_url, resource_load_info.final_url,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    AddToFeature(indices.request_count[kThirdParty], 1);
+    AddToFeature(indices.size[kThirdParty], size);
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
-  switch (resource_load_info.request_destination) {
-    case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
-      break;
-    case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
-      break;
-    case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
-      break;
-    case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
-      break;
-    case network::mojom::RequestDestination::kAudio:
-    case network::mojom::RequestDestination::kTrack:
-    case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
-      break;
-    default:
-      resource_type = "other";
-      break;
-  }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  AddToFeature(indices.request_count[kTotal], 1);
+  AddToFeature(indices.size[kTotal], size);
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+
+  const ResourceType resource_type =
+      GetResourceType(resource_load_info.request_destination);
+  AddToFeature(indices.request_count[resource_type], 1);
+  AddToFeature(indices.size[resource_type], size);
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,38 +181,55 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  if (GetFeature(GetFeatureIndices().adblock_requests) < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
-    VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    VLOG(3) << "Predicting on features:";
+    for (size_t i = 0; i < feature_count; i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_total_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  features_.fill(0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
+double BandwidthSavingsPredictor::GetFeature(
+    absl::optional<size_t> index) const {
+  return index ? features_[*index] : 0;
+}
+
+void BandwidthSavingsPredictor::SetFeature(absl::optional<size_t> index,
+                                           double value) {
+  if (index)
+    features_[*index] = value;
+}
+
+void BandwidthSavingsPredictor::AddToFeature(absl::optional<size_t> index,
+                                             double value) {
+  if (index)
+    features_[*index] += value;
+}
+
 }  // namespace brave_perf_predictor
@@ -6,11 +6,12 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
+#include <array>
 #include <string>
 
-#include "base/containers/flat_map.h"
-#include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace page_load_metrics {
@@ -49,7 +50,7 @@ class BandwidthSavingsPredictor {
 
   void OnPageLoadTimingUpdated(
       const page_load_metrics::mojom::PageLoadTiming& timing);
-  void OnSubresourceBlocked(const std::string& resource_url);
+  void OnSubresourceBlocked(const GURL& resource_url);
   void OnResourceLoadComplete(
       const GURL& main_frame_url,
       const blink::mojom::ResourceLoadInfo& resource_load_info);
@@ -57,14 +58,18 @@ class BandwidthSavingsPredictor {
   void Reset();
 
  private:
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseBlocked);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
-                           FeaturiseResourceLoading);
+  friend class BandwidthSavingsPredictorTest;
+
+  double GetFeature(absl::optional<size_t> index) const;
+  void SetFeature(absl::optional<size_t> index, double value);
+  void AddToFeature(absl::optional<size_t> index, double value);
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Model features, in the order of |feature_sequence|.
+  std::array<double, feature_count> features_{};
+  // Not a model feature, only used to sanity check the prediction.
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
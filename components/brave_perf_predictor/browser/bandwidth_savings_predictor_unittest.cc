@@ -6,11 +6,15 @@
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include "base/containers/flat_map.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
@@ -32,49 +36,55 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
   }
 
  protected:
+  double feature(const std::string& name) const {
+    const auto index = GetFeatureIndex(name);
+    EXPECT_TRUE(index) << name;
+    return index ? predictor_->features_[*index] : 0;
+  }
+
   base::test::TaskEnvironment env_;
   std::unique_ptr<NamedThirdPartyRegistry> tp_registry_;
   std::unique_ptr<BandwidthSavingsPredictor> predictor_;
 };
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
-  predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
+  predictor_->OnSubresourceBlocked(GURL("https://google-analytics.com"));
+  EXPECT_EQ(feature("adblockRequests"), 1);
+  EXPECT_EQ(feature("thirdParties.Google Analytics.blocked"),
             1);
-  predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  predictor_->OnSubresourceBlocked(GURL("https://test.m.facebook.com"));
+  EXPECT_EQ(feature("adblockRequests"), 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(feature("metrics.firstMeaningfulPaint"), 0);
+  EXPECT_EQ(feature("metrics.observedDomContentLoaded"), 0);
+  EXPECT_EQ(feature("metrics.observedFirstVisualChange"), 0);
+  EXPECT_EQ(feature("metrics.observedLoad"), 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::Milliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(feature("metrics.observedDomContentLoaded"), 1000);
 
   timing->document_timing->load_event_start = base::Milliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(feature("metrics.observedLoad"), 2000);
 
   timing->paint_timing->first_meaningful_paint = base::Milliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(feature("metrics.firstMeaningfulPaint"), 1500);
 
   timing->paint_timing->first_contentful_paint = base::Milliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(feature("metrics.observedFirstVisualChange"), 800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(feature("resources.third-party.requestCount"), 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -83,9 +93,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(feature("resources.third-party.requestCount"), 0);
+  EXPECT_EQ(feature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(feature("resources.stylesheet.size"), 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -93,14 +103,14 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(feature("resources.third-party.requestCount"), 1);
+  EXPECT_EQ(feature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(feature("resources.script.requestCount"), 1);
+  EXPECT_EQ(feature("resources.stylesheet.size"), 1000);
+  EXPECT_EQ(feature("resources.script.size"), 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(feature("resources.total.requestCount"), 2);
+  EXPECT_EQ(feature("resources.total.size"), 2001);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
@@ -146,7 +156,8 @@ TEST_F(BandwidthSavingsPredictorTest, PredictNonZero) {
   res->total_received_bytes = 200000;
   predictor_->OnResourceLoadComplete(main_frame, *res);
 
-  predictor_->OnSubresourceBlocked("https://google-analytics.com/ga.js");
+  predictor_->OnSubresourceBlocked(
+      GURL("https://google-analytics.com/ga.js"));
   // resource still seen as complete, but with 0 bytes
   auto blocked = predictors::CreateResourceLoadInfo(
       "https://google-analytics.com/ga.js",
@@ -157,4 +168,57 @@ TEST_F(BandwidthSavingsPredictorTest, PredictNonZero) {
   EXPECT_NE(predictor_->PredictSavingsBytes(), 0);
 }
 
+TEST_F(BandwidthSavingsPredictorTest, ReplayLargePage) {
+  const GURL main_frame("https://brave.com");
+  constexpr int kResourceCount = 5000;
+  const network::mojom::RequestDestination kDestinations[] = {
+      network::mojom::RequestDestination::kScript,
+      network::mojom::RequestDestination::kImage,
+      network::mojom::RequestDestination::kStyle,
+      network::mojom::RequestDestination::kFont,
+      network::mojom::RequestDestination::kVideo};
+  const char* kThirdPartyHosts[] = {"google-analytics.com", "facebook.com",
+                                    "doubleclick.net", "example.com"};
+
+  std::vector<GURL> blocked_urls;
+  std::vector<blink::mojom::ResourceLoadInfoPtr> resources;
+  for (int i = 0; i < kResourceCount; i++) {
+    const bool is_third_party = i % 2 == 1;
+    const std::string host =
+        is_third_party ? kThirdPartyHosts[(i / 2) % 4] : "brave.com";
+    const std::string url =
+        "https://" + host + "/resource" + base::NumberToString(i);
+    auto resource =
+        predictors::CreateResourceLoadInfo(url, kDestinations[i % 5]);
+    if (is_third_party && i % 3 == 0) {
+      blocked_urls.emplace_back(url);
+      resource->raw_body_bytes = 0;
+    } else {
+      resource->raw_body_bytes = 1000;
+      resource->total_received_bytes = 1000;
+    }
+    resources.push_back(std::move(resource));
+  }
+
+  for (const auto& url : blocked_urls)
+    predictor_->OnSubresourceBlocked(url);
+  for (const auto& resource : resources)
+    predictor_->OnResourceLoadComplete(main_frame, *resource);
+  const double prediction = predictor_->PredictSavingsBytes();
+
+  EXPECT_NE(0, prediction);
+  EXPECT_EQ(feature("adblockRequests"), blocked_urls.size());
+  EXPECT_EQ(feature("thirdParties.Google Analytics.blocked"), 1);
+  EXPECT_EQ(feature("thirdParties.Facebook.blocked"), 1);
+  EXPECT_EQ(feature("resources.total.requestCount"), kResourceCount);
+  EXPECT_EQ(feature("resources.third-party.requestCount"), kResourceCount / 2);
+  EXPECT_EQ(feature("resources.script.requestCount"), kResourceCount / 5);
+  EXPECT_EQ(feature("resources.total.size"),
+            (kResourceCount - blocked_urls.size()) * 1000);
+
+  predictor_->Reset();
+  EXPECT_EQ(feature("resources.total.requestCount"), 0);
+  EXPECT_EQ(predictor_->PredictSavingsBytes(), 0);
+}
+
 }  // namespace brave_perf_predictor
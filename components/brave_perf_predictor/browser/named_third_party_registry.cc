@@ -5,7 +5,9 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/containers/flat_set.h"
@@ -17,6 +19,7 @@
 #include "base/task/task_runner_util.h"
 #include "base/task/thread_pool.h"
 #include "base/values.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/grit/brave_components_resources.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -28,20 +31,51 @@ namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+NamedThirdPartyMappings::DomainNode& AddDomainNode(
+    NamedThirdPartyMappings* mappings,
+    const base::StringPiece domain) {
+  size_t node = 0;
+  base::StringPiece remaining = domain;
+  while (true) {
+    const size_t dot = remaining.rfind('.');
+    const base::StringPiece label = dot == base::StringPiece::npos
+                                        ? remaining
+                                        : remaining.substr(dot + 1);
+    auto& children = mappings->domain_nodes[node].children;
+    auto child = children.find(label);
+    if (child != children.end()) {
+      node = child->second;
+    } else {
+      const size_t child_node = mappings->domain_nodes.size();
+      children.emplace(std::string(label), child_node);
+      mappings->domain_nodes.emplace_back();
+      node = child_node;
+    }
+
+    if (dot == base::StringPiece::npos)
+      break;
+    remaining = remaining.substr(0, dot);
+  }
+  return mappings->domain_nodes[node];
+}
+
+NamedThirdPartyMappings ParseMappings(const base::StringPiece entities,
+                                      bool discard_irrelevant) {
+  NamedThirdPartyMappings mappings;
+  // Root of the domain trie
+  mappings.domain_nodes.emplace_back();
 
   // Parse the JSON
   absl::optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
     LOG(ERROR) << "Cannot parse the third-party entities list";
-    return {};
+    return mappings;
   }
 
   // Collect the mappings
+  base::flat_map<std::string, size_t> entity_index_by_name;
+  base::flat_map<std::string, size_t> entity_by_domain;
+  base::flat_map<std::string, size_t> entity_by_root_domain;
   for (auto& entity : document->GetList()) {
     const std::string* entity_name = entity.FindStringPath("name");
     if (!entity_name)
@@ -54,6 +88,15 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const auto entity_index_inserted = entity_index_by_name.emplace(
+        *entity_name, mappings.entities.size());
+    if (entity_index_inserted.second) {
+      mappings.entities.push_back(
+          {*entity_name,
+           GetFeatureIndex("thirdParties." + *entity_name + ".blocked")});
+    }
+    const size_t entity_index = entity_index_inserted.first->second;
+
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
@@ -61,33 +104,41 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
       const base::StringPiece entity_domain(entity_domain_it.GetString());
 
       const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
+          entity_by_domain.emplace(entity_domain, entity_index);
       if (!inserted.second) {
         VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
       }
       auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
           entity_domain,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+      // IP addresses and public suffixes have no root domain
+      if (root_domain.empty())
+        continue;
 
       auto root_entity_entry = entity_by_root_domain.find(root_domain);
       if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
+          root_entity_entry->second != entity_index) {
         // If there is a clash at root domain level, neither is correct
         entity_by_root_domain.erase(root_entity_entry);
       } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
+        entity_by_root_domain.emplace(root_domain, entity_index);
       }
     }
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  for (const auto& domain_entry : entity_by_domain)
+    AddDomainNode(&mappings, domain_entry.first).entity = domain_entry.second;
+  for (const auto& root_domain_entry : entity_by_root_domain) {
+    AddDomainNode(&mappings, root_domain_entry.first).root_entity =
+        root_domain_entry.second;
+  }
+
+  mappings.entities.shrink_to_fit();
+  mappings.domain_nodes.shrink_to_fit();
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+NamedThirdPartyMappings ParseFromResource(int resource_id) {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
@@ -100,16 +151,32 @@ ParseFromResource(int resource_id) {
 
 }  // namespace
 
+NamedThirdPartyMappings::DomainNode::DomainNode() = default;
+
+NamedThirdPartyMappings::DomainNode::~DomainNode() = default;
+
+NamedThirdPartyMappings::DomainNode::DomainNode(DomainNode&&) = default;
+
+NamedThirdPartyMappings::DomainNode&
+NamedThirdPartyMappings::DomainNode::operator=(DomainNode&&) = default;
+
+NamedThirdPartyMappings::NamedThirdPartyMappings() = default;
+
+NamedThirdPartyMappings::~NamedThirdPartyMappings() = default;
+
+NamedThirdPartyMappings::NamedThirdPartyMappings(NamedThirdPartyMappings&&) =
+    default;
+
+NamedThirdPartyMappings& NamedThirdPartyMappings::operator=(
+    NamedThirdPartyMappings&&) = default;
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
-  // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  // Replaces previous mappings
   initialized_ = false;
-
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  mappings_ = ParseMappings(entities, discard_irrelevant);
+  // The trie holds only its root if no domains were loaded
+  if (mappings_.domain_nodes.size() <= 1)
     return false;
 
   initialized_ = true;
@@ -117,39 +184,117 @@ bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
 }
 
 void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+    NamedThirdPartyMappings mappings) {
+  mappings_ = std::move(mappings);
+  VLOG(2) << "Loaded " << mappings_.entities.size() << " third parties over "
+          << mappings_.domain_nodes.size() << " domain labels";
   initialized_ = true;
 }
 
-absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
+const NamedThirdParty* NamedThirdPartyRegistry::FindThirdParty(
     const base::StringPiece request_url) const {
   if (!IsInitialized()) {
     VLOG(2) << "Named Third Party Registry not initialized";
-    return absl::nullopt;
+    return nullptr;
   }
 
   const GURL url(request_url);
-  if (!url.is_valid())
-    return absl::nullopt;
+  if (!url.is_valid() || !url.has_host())
+    return nullptr;
 
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+  const auto id = GetThirdPartyIdForHost(url.host_piece());
+  if (!id)
+    return nullptr;
+  return &GetThirdPartyById(*id);
+}
+
+const NamedThirdPartyMappings::DomainNode*
+NamedThirdPartyRegistry::FindDomainNode(const base::StringPiece domain) const {
+  if (domain.empty())
+    return nullptr;
+
+  const auto& nodes = mappings_.domain_nodes;
+  size_t node = 0;
+  base::StringPiece remaining = domain;
+  while (true) {
+    const size_t dot = remaining.rfind('.');
+    const base::StringPiece label = dot == base::StringPiece::npos
+                                        ? remaining
+                                        : remaining.substr(dot + 1);
+    auto child = nodes[node].children.find(label);
+    if (child == nodes[node].children.end())
+      return nullptr;
+    node = child->second;
+
+    if (dot == base::StringPiece::npos)
+      break;
+    remaining = remaining.substr(0, dot);
+  }
+  return &nodes[node];
+}
+
+absl::optional<size_t> NamedThirdPartyRegistry::GetThirdPartyIdForHost(
+    const base::StringPiece host) const {
+  if (!IsInitialized()) {
+    VLOG(2) << "Named Third Party Registry not initialized";
+    return absl::nullopt;
+  }
+  if (host.empty())
+    return absl::nullopt;
 
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  // Walk the trie from the last label of |host| for as long as it matches
+  const auto& nodes = mappings_.domain_nodes;
+  size_t node = 0;
+  bool has_root_domain_suffix = false;
+  base::StringPiece remaining = host;
+  while (true) {
+    const size_t dot = remaining.rfind('.');
+    const base::StringPiece label = dot == base::StringPiece::npos
+                                        ? remaining
+                                        : remaining.substr(dot + 1);
+    auto child = nodes[node].children.find(label);
+    if (child == nodes[node].children.end())
+      break;
+    node = child->second;
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+    if (dot == base::StringPiece::npos) {
+      // |host| itself is a known domain, or a known root domain, which is
+      // then its own root domain.
+      if (nodes[node].entity)
+        return nodes[node].entity;
+      if (nodes[node].root_entity)
+        return nodes[node].root_entity;
+      break;
+    }
+    if (nodes[node].root_entity)
+      has_root_domain_suffix = true;
+    remaining = remaining.substr(0, dot);
   }
 
-  return absl::nullopt;
+  // The public suffix list is only needed to tell whether a known root domain
+  // which |host| ends with is in fact the root domain of |host|.
+  if (!has_root_domain_suffix)
+    return absl::nullopt;
+  const auto* root_domain_node =
+      FindDomainNode(net::registry_controlled_domains::GetDomainAndRegistry(
+          host, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES));
+  if (!root_domain_node)
+    return absl::nullopt;
+  return root_domain_node->root_entity;
+}
+
+const NamedThirdParty& NamedThirdPartyRegistry::GetThirdPartyById(
+    size_t id) const {
+  DCHECK_LT(id, mappings_.entities.size());
+  return mappings_.entities[id];
+}
+
+absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
+    const base::StringPiece request_url) const {
+  const NamedThirdParty* third_party = FindThirdParty(request_url);
+  if (!third_party)
+    return absl::nullopt;
+  return third_party->name;
 }
 
 NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
@@ -6,16 +6,52 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <functional>
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "components/keyed_service/core/keyed_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_perf_predictor {
 
+struct NamedThirdParty {
+  std::string name;
+  // Index of the "thirdParties.<name>.blocked" feature of the bandwidth
+  // prediction model, resolved once when the mappings are loaded.
+  absl::optional<size_t> blocked_feature_index;
+};
+
+// Domains of the Third Parties, as a trie over their labels in reverse order
+// (e.g. "com" -> "facebook" -> "m"), so hosts are matched without copying.
+struct NamedThirdPartyMappings {
+  struct DomainNode {
+    DomainNode();
+    ~DomainNode();
+    DomainNode(DomainNode&&);
+    DomainNode& operator=(DomainNode&&);
+
+    // Label -> index into |domain_nodes|.
+    base::flat_map<std::string, size_t, std::less<>> children;
+    // Indices into |entities| of the Third Party owning the domain ending at
+    // this node, and of the one owning it as a root (registrable) domain.
+    absl::optional<size_t> entity;
+    absl::optional<size_t> root_entity;
+  };
+
+  NamedThirdPartyMappings();
+  ~NamedThirdPartyMappings();
+  NamedThirdPartyMappings(NamedThirdPartyMappings&&);
+  NamedThirdPartyMappings& operator=(NamedThirdPartyMappings&&);
+
+  std::vector<NamedThirdParty> entities;
+  // The first node is the root of the trie.
+  std::vector<DomainNode> domain_nodes;
+};
+
 // Retrieves publicly known Third Party (organisation) for a given URL, using
 // data from the Third Party Web repository
 // (https://github.com/patrickhulce/third-party-web).
@@ -35,17 +71,23 @@ class NamedThirdPartyRegistry : public KeyedService {
   void InitializeDefault();
   absl::optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
+  // Returns the id of the Third Party of an already canonicalized |host|,
+  // which stays valid until the mappings are loaded again.
+  absl::optional<size_t> GetThirdPartyIdForHost(
+      const base::StringPiece host) const;
+  const NamedThirdParty& GetThirdPartyById(size_t id) const;
 
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(NamedThirdPartyMappings mappings);
+  const NamedThirdParty* FindThirdParty(
+      const base::StringPiece request_url) const;
+  const NamedThirdPartyMappings::DomainNode* FindDomainNode(
+      const base::StringPiece domain) const;
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  NamedThirdPartyMappings mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
@@ -5,10 +5,20 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
 #include "base/path_service.h"
+#include "base/values.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
@@ -55,6 +65,78 @@ std::string LoadFile() {
   return value;
 }
 
+// Lookup by domain and root domain maps, as the registry used to do it.
+class LegacyRegistry {
+ public:
+  explicit LegacyRegistry(const std::string& entities) {
+    auto document = base::JSONReader::Read(entities);
+    for (auto& entity : document->GetList()) {
+      const std::string* name = entity.FindStringPath("name");
+      const auto* domains = entity.FindListPath("domains");
+      if (!name || !domains || !relevant_entity_set.contains(*name))
+        continue;
+      for (auto& domain : domains->GetList()) {
+        entity_by_domain_.emplace(domain.GetString(), *name);
+        auto root_domain =
+            net::registry_controlled_domains::GetDomainAndRegistry(
+                domain.GetString(), net::registry_controlled_domains::
+                                        INCLUDE_PRIVATE_REGISTRIES);
+        if (root_domain.empty())
+          continue;
+        auto root_entry = entity_by_root_domain_.find(root_domain);
+        if (root_entry != entity_by_root_domain_.end() &&
+            root_entry->second != *name) {
+          entity_by_root_domain_.erase(root_entry);
+        } else {
+          entity_by_root_domain_.emplace(root_domain, *name);
+        }
+      }
+    }
+  }
+
+  absl::optional<std::string> GetThirdParty(const std::string& request_url) {
+    const GURL url(request_url);
+    if (!url.is_valid() || !url.has_host())
+      return absl::nullopt;
+    auto domain_entry = entity_by_domain_.find(url.host());
+    if (domain_entry != entity_by_domain_.end())
+      return domain_entry->second;
+    auto root_domain_entry = entity_by_root_domain_.find(
+        net::registry_controlled_domains::GetDomainAndRegistry(
+            url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES));
+    if (root_domain_entry != entity_by_root_domain_.end())
+      return root_domain_entry->second;
+    return absl::nullopt;
+  }
+
+ private:
+  base::flat_map<std::string, std::string> entity_by_domain_;
+  base::flat_map<std::string, std::string> entity_by_root_domain_;
+};
+
+std::vector<std::string> GetTestUrls(const std::string& entities) {
+  std::vector<std::string> urls = {"https://example.com/",
+                                   "https://brave.com/", "https://127.0.0.1/",
+                                   "https://localhost/", "https://co.uk/"};
+  auto document = base::JSONReader::Read(entities);
+  for (auto& entity : document->GetList()) {
+    const auto* domains = entity.FindListPath("domains");
+    if (!domains)
+      continue;
+    for (auto& domain : domains->GetList()) {
+      const std::string& host = domain.GetString();
+      urls.push_back("https://" + host + "/script.js");
+      urls.push_back("https://cdn." + host + "/script.js");
+      urls.push_back("https://a.b." + host + "/");
+      urls.push_back("https://" + host + ".example/");
+      const size_t dot = host.find('.');
+      if (dot != std::string::npos)
+        urls.push_back("https://x" + host.substr(dot) + "/");
+    }
+  }
+  return urls;
+}
+
 }  // namespace
 
 TEST(NamedThirdPartyRegistryTest, HandlesEmptyJSON) {
@@ -119,4 +201,54 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, ResolvesBlockedFeatureIndexTest) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  auto dataset = LoadFile();
+  extractor->LoadMappings(dataset, true);
+  auto id = extractor->GetThirdPartyIdForHost("test.m.facebook.com");
+  ASSERT_TRUE(id.has_value());
+  EXPECT_EQ(extractor->GetThirdPartyById(*id).blocked_feature_index,
+            GetFeatureIndex("thirdParties.Facebook.blocked"));
+}
+
+TEST(NamedThirdPartyRegistryTest, ExtractsThirdPartyForHostTest) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  auto dataset = LoadFile();
+  extractor->LoadMappings(dataset, true);
+
+  auto id = extractor->GetThirdPartyIdForHost("test.m.facebook.com");
+  ASSERT_TRUE(id.has_value());
+  EXPECT_EQ(extractor->GetThirdPartyById(*id).name, "Facebook");
+  EXPECT_EQ(id, extractor->GetThirdPartyIdForHost("connect.facebook.net"));
+  EXPECT_NE(id, extractor->GetThirdPartyIdForHost("google-analytics.com"));
+  EXPECT_FALSE(extractor->GetThirdPartyIdForHost("example.com"));
+  EXPECT_FALSE(extractor->GetThirdPartyIdForHost("com"));
+  EXPECT_FALSE(extractor->GetThirdPartyIdForHost(""));
+}
+
+TEST(NamedThirdPartyRegistryTest, MatchesLegacyLookupTest) {
+  auto dataset = LoadFile();
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  ASSERT_TRUE(extractor->LoadMappings(dataset, true));
+  LegacyRegistry legacy(dataset);
+
+  for (const auto& url : GetTestUrls(dataset))
+    EXPECT_EQ(legacy.GetThirdParty(url), extractor->GetThirdParty(url)) << url;
+}
+
+TEST(NamedThirdPartyRegistryTest, MatchesLegacyLookupForHostsTest) {
+  auto dataset = LoadFile();
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  ASSERT_TRUE(extractor->LoadMappings(dataset, true));
+  LegacyRegistry legacy(dataset);
+
+  for (const auto& url : GetTestUrls(dataset)) {
+    const auto id = extractor->GetThirdPartyIdForHost(GURL(url).host_piece());
+    absl::optional<std::string> third_party;
+    if (id)
+      third_party = extractor->GetThirdPartyById(*id).name;
+    EXPECT_EQ(legacy.GetThirdParty(url), third_party) << url;
+  }
+}
+
 }  // namespace brave_perf_predictor
@@ -52,7 +52,7 @@ void PerfPredictorTabHelper::RegisterProfilePrefs(
 
 // static
 void PerfPredictorTabHelper::DispatchBlockedEvent(
-    const std::string& subresource,
+    const GURL& subresource,
     int frame_tree_node_id) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
@@ -97,8 +97,7 @@ void PerfPredictorTabHelper::RecordSavings() {
   }
 }
 
-void PerfPredictorTabHelper::OnBlockedSubresource(
-    const std::string& subresource) {
+void PerfPredictorTabHelper::OnBlockedSubresource(const GURL& subresource) {
   bandwidth_predictor_->OnSubresourceBlocked(subresource);
 }
 
@@ -55,13 +55,13 @@ class PerfPredictorTabHelper
       const page_load_metrics::mojom::PageLoadTiming& timing);
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
   // Called from Brave Shields
-  static void DispatchBlockedEvent(const std::string& subresource,
+  static void DispatchBlockedEvent(const GURL& subresource,
                                    int frame_tree_node_id);
 
  private:
   friend class content::WebContentsUserData<PerfPredictorTabHelper>;
   void RecordSavings();
-  void OnBlockedSubresource(const std::string& subresource);
+  void OnBlockedSubresource(const GURL& subresource);
 
   // content::WebContentsObserver overrides.
 
@@ -281,9 +281,7 @@ std::string GetPrefPath(const std::string& name) {
 bool IsMediaLink(const GURL& url,
                  const GURL& first_party_url,
                  const GURL& referrer) {
-  return ledger::Ledger::IsMediaLink(url.spec(),
-                                     first_party_url.spec(),
-                                     referrer.spec());
+  return ledger::Ledger::IsMediaLink(url, first_party_url, referrer);
 }
 
 
@@ -758,6 +756,12 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
     return;
   }
 
+  // Most loaded resources are not media, only forward the ones the ledger
+  // records activity for.
+  if (!ledger::Ledger::IsProcessedMediaLink(url, first_party_url, referrer)) {
+    return;
+  }
+
   if (!ProcessPublisher(url)) {
     return;
   }
@@ -8,12 +8,31 @@
 #include <set>
 #include <string>
 
+#include "base/no_destructor.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace brave_shields {
 
+namespace {
+
+// Parsing patterns is not cheap, and the fingerprinting rules are scanned for
+// every frame.
+const ContentSettingsPattern& BalancedPattern() {
+  static const base::NoDestructor<ContentSettingsPattern> pattern(
+      ContentSettingsPattern::FromString("https://balanced"));
+  return *pattern;
+}
+
+const ContentSettingsPattern& WildcardPattern() {
+  static const base::NoDestructor<ContentSettingsPattern> pattern(
+      ContentSettingsPattern::Wildcard());
+  return *pattern;
+}
+
+}  // namespace
+
 ContentSetting GetBraveFPContentSettingFromRules(
     const ContentSettingsForOneType& fp_rules,
     const GURL& primary_url) {
@@ -21,23 +40,21 @@ ContentSetting GetBraveFPContentSettingFromRules(
   absl::optional<ContentSettingPatternSource> global_fp_balanced_rule;
 
   for (const auto& rule : fp_rules) {
-    if (rule.primary_pattern != ContentSettingsPattern::Wildcard() &&
+    if (rule.primary_pattern != WildcardPattern() &&
         rule.primary_pattern.Matches(primary_url)) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+      if (rule.secondary_pattern == BalancedPattern()) {
         return CONTENT_SETTING_DEFAULT;
       }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard())
+      if (rule.secondary_pattern == WildcardPattern())
         return rule.GetContentSetting();
     }
 
-    if (rule.primary_pattern == ContentSettingsPattern::Wildcard()) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+    if (rule.primary_pattern == WildcardPattern()) {
+      if (rule.secondary_pattern == BalancedPattern()) {
         DCHECK(!global_fp_rule);
         global_fp_balanced_rule = rule;
       }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard()) {
+      if (rule.secondary_pattern == WildcardPattern()) {
         DCHECK(!global_fp_balanced_rule);
         global_fp_rule = rule;
       }
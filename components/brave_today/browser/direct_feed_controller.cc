@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <codecvt>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -17,6 +18,8 @@
 #include "base/containers/flat_set.h"
 #include "base/logging.h"
 #include "base/strings/string_util.h"
+#include "base/task/task_traits.h"
+#include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/html_parsing.h"
@@ -29,6 +32,8 @@
 #include "components/prefs/pref_service.h"
 #include "net/base/load_flags.h"
 #include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -71,7 +76,8 @@ mojom::ArticlePtr RustFeedItemToArticle(const FeedItem& rust_feed_item) {
 
 DirectFeedController::DirectFeedController(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
-    : url_loader_factory_(url_loader_factory) {}
+    : url_loader_factory_(url_loader_factory),
+      cached_feeds_(kMaxCachedDirectFeeds) {}
 
 DirectFeedController::~DirectFeedController() = default;
 
@@ -291,12 +297,30 @@ void DirectFeedController::DownloadFeedContent(const GURL& feed_url,
 
 void DirectFeedController::DownloadFeed(const GURL& feed_url,
                                         DownloadFeedCallback callback) {
+  DownloadFeed(feed_url, /* is_conditional */ true, std::move(callback));
+}
+
+void DirectFeedController::DownloadFeed(const GURL& feed_url,
+                                        bool is_conditional,
+                                        DownloadFeedCallback callback) {
   // Make request
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = feed_url;
   request->load_flags = net::LOAD_DO_NOT_SAVE_COOKIES;
   request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   request->method = net::HttpRequestHeaders::kGetMethod;
+  // Only ask for the feed if it changed since we last parsed it.
+  auto cached_feed = cached_feeds_.Peek(feed_url);
+  if (is_conditional && cached_feed != cached_feeds_.end()) {
+    if (!cached_feed->second.etag.empty()) {
+      request->headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch,
+                                 cached_feed->second.etag);
+    }
+    if (!cached_feed->second.last_modified.empty()) {
+      request->headers.SetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+                                 cached_feed->second.last_modified);
+    }
+  }
   auto url_loader = network::SimpleURLLoader::Create(
       std::move(request), GetNetworkTrafficAnnotationTag());
   url_loader->SetRetryOptions(
@@ -308,7 +332,7 @@ void DirectFeedController::DownloadFeed(const GURL& feed_url,
       url_loader_factory_.get(),
       // Handle response
       base::BindOnce(&DirectFeedController::OnResponse, base::Unretained(this),
-                     iter, std::move(callback), feed_url),
+                     iter, std::move(callback), feed_url, is_conditional),
       5 * 1024 * 1024);
 }
 
@@ -316,42 +340,108 @@ void DirectFeedController::OnResponse(
     SimpleURLLoaderList::iterator iter,
     DownloadFeedCallback callback,
     const GURL& feed_url,
+    bool is_conditional,
     const std::unique_ptr<std::string> response_body) {
   // Parse response data
   auto* loader = iter->get();
   auto response_code = -1;
-  base::flat_map<std::string, std::string> headers;
+  auto cached_feed = std::make_unique<CachedFeed>();
   if (loader->ResponseInfo()) {
     auto headers_list = loader->ResponseInfo()->headers;
     if (headers_list) {
       response_code = headers_list->response_code();
+      headers_list->GetNormalizedHeader("etag", &cached_feed->etag);
+      headers_list->GetNormalizedHeader("last-modified",
+                                        &cached_feed->last_modified);
     }
   }
   url_loaders_.erase(iter);
+  // Feed has not changed since we last parsed it
+  if (response_code == net::HTTP_NOT_MODIFIED) {
+    auto result = GetCachedFeedResponse(feed_url);
+    if (result) {
+      VLOG(1) << feed_url.spec() << " not modified, using cached feed.";
+      std::move(callback).Run(std::move(result));
+      return;
+    }
+    // The cached feed was evicted while the request was in flight, so there
+    // is nothing to serve. Ask for the full feed instead.
+    if (is_conditional) {
+      VLOG(1) << feed_url.spec() << " not modified, but no longer cached.";
+      DownloadFeed(feed_url, /* is_conditional */ false, std::move(callback));
+      return;
+    }
+  }
   // Validate if we get a feed
   std::string body_content = response_body ? *response_body : "";
   // TODO(petemill): handle any url redirects and change the stored feed url?
-  auto result = std::make_unique<DirectFeedResponse>(DirectFeedResponse());
-  result->url = feed_url;
   if (response_code < 200 || response_code >= 300 || body_content.empty()) {
     VLOG(1) << feed_url.spec()
             << " invalid response, status: " << response_code;
+    auto result = std::make_unique<DirectFeedResponse>(DirectFeedResponse());
+    result->url = feed_url;
     std::move(callback).Run(std::move(result));
     return;
   }
-  // Reponse is valid, but still might not be a feed
-  FeedData data;
-  if (!parse_feed_string(::rust::String(body_content), data)) {
+  // Servers which don't support conditional requests may still send the same
+  // content, which we don't need to parse again.
+  cached_feed->body_hash = std::hash<std::string>()(body_content);
+  auto existing_feed = cached_feeds_.Get(feed_url);
+  if (existing_feed != cached_feeds_.end() &&
+      existing_feed->second.body_hash == cached_feed->body_hash) {
+    existing_feed->second.etag = cached_feed->etag;
+    existing_feed->second.last_modified = cached_feed->last_modified;
+    std::move(callback).Run(GetCachedFeedResponse(feed_url));
+    return;
+  }
+  // Reponse is valid, but still might not be a feed. Parsing large feeds is
+  // expensive so do it off the UI thread.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(
+          [](std::string body_content, std::unique_ptr<CachedFeed> cached_feed)
+              -> std::unique_ptr<CachedFeed> {
+            if (!parse_feed_string(::rust::String(body_content),
+                                   cached_feed->data)) {
+              return nullptr;
+            }
+            return cached_feed;
+          },
+          std::move(body_content), std::move(cached_feed)),
+      base::BindOnce(&DirectFeedController::OnFeedParsed,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                     feed_url));
+}
+
+void DirectFeedController::OnFeedParsed(
+    DownloadFeedCallback callback,
+    const GURL& feed_url,
+    std::unique_ptr<CachedFeed> cached_feed) {
+  auto result = std::make_unique<DirectFeedResponse>(DirectFeedResponse());
+  result->url = feed_url;
+  if (!cached_feed) {
     VLOG(1) << feed_url.spec() << " not a valid feed.";
-    VLOG(2) << "Response body was:";
-    VLOG(2) << body_content;
     std::move(callback).Run(std::move(result));
     return;
   }
   // Valid feed
   result->success = true;
-  result->data = data;
+  result->data = cached_feed->data;
+  cached_feeds_.Put(feed_url, std::move(*cached_feed));
   std::move(callback).Run(std::move(result));
 }
 
+std::unique_ptr<DirectFeedResponse> DirectFeedController::GetCachedFeedResponse(
+    const GURL& feed_url) {
+  auto cached_feed = cached_feeds_.Get(feed_url);
+  if (cached_feed == cached_feeds_.end()) {
+    return nullptr;
+  }
+  auto result = std::make_unique<DirectFeedResponse>(DirectFeedResponse());
+  result->url = feed_url;
+  result->success = true;
+  result->data = cached_feed->second.data;
+  return result;
+}
+
 }  // namespace brave_news
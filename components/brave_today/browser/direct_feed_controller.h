@@ -12,7 +12,9 @@
 #include <vector>
 
 #include "base/callback_forward.h"
+#include "base/containers/lru_cache.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/common/brave_news.mojom-shared.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
@@ -29,6 +31,7 @@ class SimpleURLLoader;
 namespace brave_news {
 
 constexpr std::size_t kMaxArticlesPerDirectFeedSource = 100;
+constexpr std::size_t kMaxCachedDirectFeeds = 100;
 
 struct DirectFeedResponse {
  public:
@@ -63,19 +66,45 @@ class DirectFeedController {
                  mojom::BraveNewsController::FindFeedsCallback callback);
 
  private:
+  friend class DirectFeedControllerTest;
+
+  // Last successfully parsed content of a feed, along with the validators
+  // needed to make a conditional request for it.
+  struct CachedFeed {
+    std::string etag;
+    std::string last_modified;
+    size_t body_hash = 0;
+    FeedData data;
+  };
+
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
   void DownloadFeedContent(const GURL& feed_url,
                            const std::string& publisher_id,
                            GetArticlesCallback callback);
   void DownloadFeed(const GURL& feed_url, DownloadFeedCallback callback);
+  // Conditional requests send the validators of the cached feed, if any.
+  void DownloadFeed(const GURL& feed_url,
+                    bool is_conditional,
+                    DownloadFeedCallback callback);
   void OnResponse(SimpleURLLoaderList::iterator iter,
                   DownloadFeedCallback callback,
                   const GURL& feed_url,
+                  bool is_conditional,
                   const std::unique_ptr<std::string> response_body);
+  void OnFeedParsed(DownloadFeedCallback callback,
+                    const GURL& feed_url,
+                    std::unique_ptr<CachedFeed> cached_feed);
+  std::unique_ptr<DirectFeedResponse> GetCachedFeedResponse(
+      const GURL& feed_url);
 
   SimpleURLLoaderList url_loaders_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  // Parsed feeds by feed url, used to serve unchanged feeds without
+  // downloading or parsing them again.
+  base::LRUCache<GURL, CachedFeed> cached_feeds_;
+
+  base::WeakPtrFactory<DirectFeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
@@ -6,13 +6,25 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_today/browser/direct_feed_controller.h"
 #include "brave/components/brave_today/rust/lib.rs.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_news {
@@ -140,4 +152,175 @@ TEST(BraveNewsDirectFeed, ParseFeed) {
             "c5f85f34aa685221604f7e434415ca82");
 }
 
+class DirectFeedControllerTest : public testing::Test {
+ public:
+  DirectFeedControllerTest()
+      : direct_feed_controller_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &test_url_loader_factory_)) {}
+
+ protected:
+  struct VerifyResult {
+    bool is_valid = false;
+    std::string title;
+  };
+
+  // Starts verifying |feed_url|, which will be pending until a response is
+  // simulated.
+  void VerifyFeedUrl(const GURL& feed_url) {
+    direct_feed_controller_.VerifyFeedUrl(
+        feed_url, base::BindOnce(
+                      [](std::vector<VerifyResult>* results, const bool is_valid,
+                         const std::string& title) {
+                        results->push_back({is_valid, title});
+                      },
+                      &results_));
+    task_environment_.RunUntilIdle();
+  }
+
+  // Returns the If-None-Match header of the pending request for |feed_url|.
+  std::string GetPendingIfNoneMatch(const GURL& feed_url) {
+    for (auto& pending_request : *test_url_loader_factory_.pending_requests()) {
+      if (pending_request.request.url == feed_url) {
+        std::string etag;
+        pending_request.request.headers.GetHeader(
+            net::HttpRequestHeaders::kIfNoneMatch, &etag);
+        return etag;
+      }
+    }
+    ADD_FAILURE() << "No pending request for " << feed_url;
+    return "";
+  }
+
+  void RespondToPendingRequest(const GURL& feed_url,
+                               net::HttpStatusCode status,
+                               const std::string& etag,
+                               const std::string& body) {
+    auto head = network::CreateURLResponseHead(status);
+    if (!etag.empty()) {
+      head->headers->AddHeader("ETag", etag);
+    }
+    ASSERT_TRUE(test_url_loader_factory_.SimulateResponseForPendingRequest(
+        feed_url, network::URLLoaderCompletionStatus(), std::move(head),
+        body));
+    task_environment_.RunUntilIdle();
+  }
+
+  void SetCachedFeedTitle(const GURL& feed_url, const std::string& title) {
+    auto cached_feed = direct_feed_controller_.cached_feeds_.Peek(feed_url);
+    ASSERT_NE(cached_feed, direct_feed_controller_.cached_feeds_.end());
+    cached_feed->second.data.title = title;
+  }
+
+  bool IsCached(const GURL& feed_url) {
+    return direct_feed_controller_.cached_feeds_.Peek(feed_url) !=
+           direct_feed_controller_.cached_feeds_.end();
+  }
+
+  // Fills the cache with other feeds until |feed_url| is evicted.
+  void EvictFromCache(const GURL& feed_url) {
+    for (size_t i = 0; i < kMaxCachedDirectFeeds; i++) {
+      const GURL other_feed_url(
+          base::StrCat({"https://other.example.com/feed", base::NumberToString(i),
+                        ".xml"}));
+      VerifyFeedUrl(other_feed_url);
+      RespondToPendingRequest(other_feed_url, net::HTTP_OK, "", GetFeedJson());
+    }
+    ASSERT_FALSE(IsCached(feed_url));
+  }
+
+  const GURL feed_url_{"https://www.example.com/feed.xml"};
+
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory test_url_loader_factory_;
+  DirectFeedController direct_feed_controller_;
+  std::vector<VerifyResult> results_;
+};
+
+TEST_F(DirectFeedControllerTest, ServeNotModifiedFeedFromCache) {
+  VerifyFeedUrl(feed_url_);
+  EXPECT_EQ("", GetPendingIfNoneMatch(feed_url_));
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "\"v1\"", GetFeedJson());
+  ASSERT_EQ(1u, results_.size());
+  ASSERT_TRUE(results_[0].is_valid);
+
+  VerifyFeedUrl(feed_url_);
+  EXPECT_EQ("\"v1\"", GetPendingIfNoneMatch(feed_url_));
+  RespondToPendingRequest(feed_url_, net::HTTP_NOT_MODIFIED, "\"v1\"", "");
+
+  ASSERT_EQ(2u, results_.size());
+  EXPECT_TRUE(results_[1].is_valid);
+  EXPECT_EQ(results_[0].title, results_[1].title);
+}
+
+TEST_F(DirectFeedControllerTest, DetectUnchangedFeedByBodyHash) {
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "", GetFeedJson());
+  // Only a cache hit can return this title.
+  SetCachedFeedTitle(feed_url_, "Cached title");
+
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "", GetFeedJson());
+
+  ASSERT_EQ(2u, results_.size());
+  EXPECT_TRUE(results_[1].is_valid);
+  EXPECT_EQ("Cached title", results_[1].title);
+}
+
+TEST_F(DirectFeedControllerTest, ReplaceCachedFeedWhenBodyChanged) {
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "", GetFeedJson());
+  SetCachedFeedTitle(feed_url_, "Cached title");
+
+  std::string changed_feed = GetFeedJson();
+  base::ReplaceFirstSubstringAfterOffset(&changed_feed, 0, "| A Site",
+                                         "| Another Site");
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "", changed_feed);
+
+  ASSERT_EQ(2u, results_.size());
+  EXPECT_TRUE(results_[1].is_valid);
+  EXPECT_NE(std::string::npos, results_[1].title.find("Another Site"));
+
+  // The changed feed is cached too.
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "", changed_feed);
+  ASSERT_EQ(3u, results_.size());
+  EXPECT_EQ(results_[1].title, results_[2].title);
+}
+
+TEST_F(DirectFeedControllerTest, EvictLeastRecentlyUsedFeed) {
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "\"v1\"", GetFeedJson());
+  ASSERT_TRUE(IsCached(feed_url_));
+
+  EvictFromCache(feed_url_);
+
+  // Without a cached feed there is nothing to validate against.
+  VerifyFeedUrl(feed_url_);
+  EXPECT_EQ("", GetPendingIfNoneMatch(feed_url_));
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "\"v1\"", GetFeedJson());
+  ASSERT_TRUE(results_.back().is_valid);
+}
+
+TEST_F(DirectFeedControllerTest, RefetchWhenNotModifiedFeedWasEvicted) {
+  VerifyFeedUrl(feed_url_);
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "\"v1\"", GetFeedJson());
+
+  // The conditional request is still in flight while the feed is evicted.
+  VerifyFeedUrl(feed_url_);
+  EXPECT_EQ("\"v1\"", GetPendingIfNoneMatch(feed_url_));
+  EvictFromCache(feed_url_);
+  const size_t results_count = results_.size();
+  RespondToPendingRequest(feed_url_, net::HTTP_NOT_MODIFIED, "\"v1\"", "");
+
+  // The feed is requested again, without validators.
+  EXPECT_EQ(results_count, results_.size());
+  EXPECT_EQ("", GetPendingIfNoneMatch(feed_url_));
+  RespondToPendingRequest(feed_url_, net::HTTP_OK, "\"v1\"", GetFeedJson());
+
+  ASSERT_EQ(results_count + 1, results_.size());
+  EXPECT_TRUE(results_.back().is_valid);
+}
+
 }  // namespace brave_news
@@ -8,15 +8,14 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
-#include <iterator>
-#include <list>
 #include <map>
-#include <random>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/time/time.h"
@@ -61,73 +60,168 @@ mojom::FeedItemPtr FromPromotedArticle(mojom::PromotedArticlePtr item) {
   return mojom::FeedItem::NewPromotedArticle(std::move(item));
 }
 
-bool MatchesDealsCategory(const std::string& category_name, mojom::Deal* deal) {
-  return (deal->offers_category == category_name);
+const std::string& GetCategory(const mojom::ArticlePtr& article) {
+  return article->data->category_name;
 }
 
-// Removes {count} items from a list and places them in a vector,
-// optionally filtering via {predicate}. Wraps item in a FeedItem
-// which, since it is a union type, must be created via {create}.
+const std::string& GetCategory(const mojom::PromotedArticlePtr& item) {
+  return item->data->category_name;
+}
+
+const std::string& GetCategory(const mojom::DealPtr& deal) {
+  return deal->offers_category;
+}
+
+// Holds feed items of one type sorted by score and lets cards take items
+// either in score order, from a category or publisher bucket, or randomly
+// from the recent items. Each bucket keeps a cursor past its leading taken
+// items, so taking items costs amortized O(1) rather than a scan over all
+// remaining items.
 template <class T>
-bool Take(
-    size_t count,
-    std::list<mojo::StructPtr<T>>* articles,
-    std::vector<mojom::FeedItemPtr>* results,
-    std::function<mojom::FeedItemPtr(mojo::StructPtr<T>)> create = FromArticle,
-    std::function<bool(T*)> predicate = {[](T* a) { return true; }}) {
-  auto it = articles->begin();
-  while (it != articles->end() && results->size() < count) {
-    auto should_take = predicate(it->get());
-    if (should_take) {
-      mojom::FeedItemPtr item = create(*std::make_move_iterator(it));
-      results->emplace_back(std::move(item));
-      it = articles->erase(it);
-    } else {
-      it++;
+class FeedItemIndex {
+ public:
+  using ItemPtr = mojo::StructPtr<T>;
+  using CreateCallback = mojom::FeedItemPtr (*)(ItemPtr);
+
+  // |items| must be sorted by score, ascending. Items published at or after
+  // |recent_time_limit| are also eligible for |TakeRandomRecent|.
+  FeedItemIndex(std::vector<ItemPtr> items,
+                base::Time recent_time_limit,
+                CreateCallback create)
+      : items_(std::move(items)),
+        taken_(items_.size(), false),
+        remaining_count_(items_.size()),
+        create_(create) {
+    all_.indices.reserve(items_.size());
+    for (size_t i = 0; i < items_.size(); i++) {
+      const auto& item = items_[i];
+      all_.indices.push_back(i);
+      categories_[GetCategory(item)].indices.push_back(i);
+      publishers_[item->data->publisher_id].indices.push_back(i);
+      if (!item->data->publisher_id.empty()) {
+        with_publisher_.indices.push_back(i);
+      }
+      if (item->data->publish_time >= recent_time_limit) {
+        recent_.push_back(i);
+      }
     }
   }
-  return (results->size() == count);
-}
 
-// Like Take<T> except selects randomly instead of in order.
-template <class T>
-void TakeRandom(
-    size_t count,
-    std::list<mojo::StructPtr<T>>* articles,
-    std::vector<mojom::FeedItemPtr>* results,
-    std::function<mojom::FeedItemPtr(mojo::StructPtr<T>)> create = FromArticle,
-    std::function<bool(T*)> predicate = {[](T* a) { return true; }}) {
-  auto it = articles->begin();
-  std::vector<typename std::list<mojo::StructPtr<T>>::iterator>
-      matching_iterators;
-  while (it != articles->end()) {
-    auto should_take = predicate(it->get());
-    if (should_take) {
-      matching_iterators.push_back(it);
+  FeedItemIndex(const FeedItemIndex&) = delete;
+  FeedItemIndex& operator=(const FeedItemIndex&) = delete;
+
+  size_t size() const { return remaining_count_; }
+
+  // Moves items into |results|, in score order, until it holds |count| items.
+  bool Take(size_t count, std::vector<mojom::FeedItemPtr>* results) {
+    return TakeFromBucket(&all_, count, results);
+  }
+
+  // Like |Take| but only considers items in |category_name|.
+  bool TakeFromCategory(const std::string& category_name,
+                        size_t count,
+                        std::vector<mojom::FeedItemPtr>* results) {
+    auto it = categories_.find(category_name);
+    if (it == categories_.end()) {
+      return results->size() == count;
     }
-    it++;
+    return TakeFromBucket(&it->second, count, results);
   }
-  std::random_device rd;
-  std::mt19937 g(rd());
-  std::shuffle(matching_iterators.begin(), matching_iterators.end(), g);
-  if (matching_iterators.size() > count) {
-    matching_iterators.resize(count);
+
+  // Like |Take| but only considers items from |publisher_id|.
+  bool TakeFromPublisher(const std::string& publisher_id,
+                         size_t count,
+                         std::vector<mojom::FeedItemPtr>* results) {
+    auto it = publishers_.find(publisher_id);
+    if (it == publishers_.end()) {
+      return results->size() == count;
+    }
+    return TakeFromBucket(&it->second, count, results);
   }
-  for (auto& matching_iterator : matching_iterators) {
-    auto a = std::make_move_iterator(matching_iterator);
-    auto item = create(*a);
-    results->emplace_back(std::move(item));
-    articles->erase(matching_iterator);
+
+  // Appends up to |count| randomly selected recent items to |results|.
+  void TakeRandomRecent(size_t count,
+                        std::vector<mojom::FeedItemPtr>* results) {
+    while (count > 0 && !recent_.empty()) {
+      const size_t pick = static_cast<size_t>(
+          base::RandInt(0, static_cast<int>(recent_.size()) - 1));
+      const size_t index = recent_[pick];
+      recent_[pick] = recent_.back();
+      recent_.pop_back();
+      if (taken_[index]) {
+        continue;
+      }
+      TakeAt(index, results);
+      count--;
+    }
+  }
+
+  // Returns the publisher of the highest ranked remaining item which has one,
+  // or an empty string.
+  std::string GetFirstPublisherId() {
+    SkipTaken(&with_publisher_);
+    if (with_publisher_.next == with_publisher_.indices.size()) {
+      return std::string();
+    }
+    return items_[with_publisher_.indices[with_publisher_.next]]
+        ->data->publisher_id;
+  }
+
+ private:
+  struct Bucket {
+    std::vector<size_t> indices;
+    size_t next = 0;
+  };
+
+  void SkipTaken(Bucket* bucket) {
+    while (bucket->next < bucket->indices.size() &&
+           taken_[bucket->indices[bucket->next]]) {
+      bucket->next++;
+    }
+  }
+
+  bool TakeFromBucket(Bucket* bucket,
+                      size_t count,
+                      std::vector<mojom::FeedItemPtr>* results) {
+    SkipTaken(bucket);
+    for (size_t i = bucket->next;
+         i < bucket->indices.size() && results->size() < count; i++) {
+      const size_t index = bucket->indices[i];
+      if (!taken_[index]) {
+        TakeAt(index, results);
+      }
+    }
+    SkipTaken(bucket);
+    return results->size() == count;
   }
-}
+
+  void TakeAt(size_t index, std::vector<mojom::FeedItemPtr>* results) {
+    DCHECK(!taken_[index]);
+    taken_[index] = true;
+    remaining_count_--;
+    results->emplace_back(create_(std::move(items_[index])));
+  }
+
+  std::vector<ItemPtr> items_;
+  std::vector<bool> taken_;
+  size_t remaining_count_ = 0;
+  CreateCallback create_;
+
+  Bucket all_;
+  Bucket with_publisher_;
+  base::flat_map<std::string, Bucket> categories_;
+  base::flat_map<std::string, Bucket> publishers_;
+  // Unordered pool of recent items, taken items are removed lazily.
+  std::vector<size_t> recent_;
+};
 
 // Decides which content to take for a specific item in the feed.
 // Items approximately correspond to "cards" in the UI, although an item
 // could be 2 cards (e.g. HEADLINE_PAIRED) or multiple
 // articles (e.g. CATEGORY_GROUP).
-void BuildFeedPageItem(std::list<mojom::ArticlePtr>* articles,
-                       std::list<mojom::PromotedArticlePtr>* promoted_articles,
-                       std::list<mojom::DealPtr>* deals,
+void BuildFeedPageItem(FeedItemIndex<mojom::Article>* articles,
+                       FeedItemIndex<mojom::PromotedArticle>* promoted_articles,
+                       FeedItemIndex<mojom::Deal>* deals,
                        const std::string& deal_category_name,
                        const std::string& article_category_name,
                        bool is_random,
@@ -136,18 +230,12 @@ void BuildFeedPageItem(std::list<mojom::ArticlePtr>* articles,
   if (is_random) {
     // Additional difference for is_random is that we only consider items from
     // the last 48hrs.
-    base::Time time_limit = base::Time::Now() - base::Days(2);
-    auto match_is_recent = [time_limit](mojom::Article* article) {
-      return (article->data->publish_time >= time_limit);
-    };
     switch (page_item->card_type) {
       case CardType::HEADLINE:
-        TakeRandom<mojom::Article>(1u, articles, &page_item->items, FromArticle,
-                                   match_is_recent);
+        articles->TakeRandomRecent(1u, &page_item->items);
         break;
       case CardType::HEADLINE_PAIRED:
-        TakeRandom<mojom::Article>(2u, articles, &page_item->items, FromArticle,
-                                   match_is_recent);
+        articles->TakeRandomRecent(2u, &page_item->items);
         break;
       default:
         VLOG(1) << "Card Type not handled for is_random: "
@@ -158,46 +246,26 @@ void BuildFeedPageItem(std::list<mojom::ArticlePtr>* articles,
   // Not having enough articles is the only real reason to abandon a page.
   switch (page_item->card_type) {
     case CardType::HEADLINE:
-      Take<mojom::Article>(1u, articles, &page_item->items, FromArticle);
+      articles->Take(1u, &page_item->items);
       break;
     case CardType::HEADLINE_PAIRED:
-      Take<mojom::Article>(2u, articles, &page_item->items, FromArticle);
+      articles->Take(2u, &page_item->items);
       break;
     case CardType::CATEGORY_GROUP:
-      Take<mojom::Article>(
-          3u, articles, &page_item->items, FromArticle,
-          [article_category_name](mojom::Article* article) {
-            return (article->data->category_name == article_category_name);
-          });
+      articles->TakeFromCategory(article_category_name, 3u, &page_item->items);
       break;
-    case CardType::PUBLISHER_GROUP: {
+    case CardType::PUBLISHER_GROUP:
       // Choose the first publisher available
-      std::string publisher_id;
-      for (auto& article : *articles) {
-        if (article->data->publisher_id.empty()) {
-          continue;
-        }
-        publisher_id = article.get()->data->publisher_id;
-        break;
-      }
-      Take<mojom::Article>(
-          3u, articles, &page_item->items, FromArticle,
-          [publisher_id](mojom::Article* article) {
-            return (article->data->publisher_id == publisher_id);
-          });
+      articles->TakeFromPublisher(articles->GetFirstPublisherId(), 3u,
+                                  &page_item->items);
       break;
-    }
     case CardType::DEALS:
-      Take<mojom::Deal>(3u, deals, &page_item->items, FromDeal,
-                        [deal_category_name](mojom::Deal* deal) {
-                          return MatchesDealsCategory(deal_category_name, deal);
-                        });
+      deals->TakeFromCategory(deal_category_name, 3u, &page_item->items);
       if (page_item->items.size() < 3u) {
         // Supplement with deals from other categories
         size_t supplemental_count =
             std::min(3u - page_item->items.size(), deals->size());
-        Take<mojom::Deal>(supplemental_count, deals, &page_item->items,
-                          FromDeal);
+        deals->Take(supplemental_count, &page_item->items);
       }
       break;
     case CardType::DISPLAY_AD:
@@ -205,8 +273,7 @@ void BuildFeedPageItem(std::list<mojom::ArticlePtr>* articles,
       // closer to this item being viewed.
       break;
     case CardType::PROMOTED_ARTICLE:
-      Take<mojom::PromotedArticle>(1u, promoted_articles, &page_item->items,
-                                   FromPromotedArticle);
+      promoted_articles->Take(1u, &page_item->items);
       break;
   }
 }
@@ -258,9 +325,9 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
                const std::unordered_set<std::string>& history_hosts,
                Publishers* publishers,
                mojom::Feed* feed) {
-  std::list<mojom::ArticlePtr> articles;
-  std::list<mojom::PromotedArticlePtr> promoted_articles;
-  std::list<mojom::DealPtr> deals;
+  std::vector<mojom::ArticlePtr> articles;
+  std::vector<mojom::PromotedArticlePtr> promoted_articles;
+  std::vector<mojom::DealPtr> deals;
   std::hash<std::string> hasher;
   for (auto& item : feed_items) {
     if (!ShouldDisplayFeedItem(item, publishers)) {
@@ -302,16 +369,20 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
   VLOG(1) << "Got deals # " << deals.size();
   VLOG(1) << "Got promoted articles # " << promoted_articles.size();
   // Sort by score, ascending
-  articles.sort([](mojom::ArticlePtr& a, mojom::ArticlePtr& b) {
-    return (a.get()->data->score < b.get()->data->score);
-  });
-  promoted_articles.sort(
-      [](mojom::PromotedArticlePtr& a, mojom::PromotedArticlePtr& b) {
-        return (a.get()->data->score < b.get()->data->score);
+  std::stable_sort(articles.begin(), articles.end(),
+                   [](const mojom::ArticlePtr& a, const mojom::ArticlePtr& b) {
+                     return (a->data->score < b->data->score);
+                   });
+  std::stable_sort(
+      promoted_articles.begin(), promoted_articles.end(),
+      [](const mojom::PromotedArticlePtr& a,
+         const mojom::PromotedArticlePtr& b) {
+        return (a->data->score < b->data->score);
       });
-  deals.sort([](mojom::DealPtr& a, mojom::DealPtr& b) {
-    return (a.get()->data->score < b.get()->data->score);
-  });
+  std::stable_sort(deals.begin(), deals.end(),
+                   [](const mojom::DealPtr& a, const mojom::DealPtr& b) {
+                     return (a->data->score < b->data->score);
+                   });
   // Get unique categories present with article counts
   std::map<std::string, std::int32_t> category_counts;
   for (auto const& article : articles) {
@@ -358,19 +429,19 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
               return (deal_category_counts.at(a) < deal_category_counts.at(b));
             });
   VLOG(1) << "Got deal categories # " << deal_category_names_by_priority.size();
+  // Index items so that cards don't need to scan all remaining items.
+  // Random cards only consider items from the last 48hrs.
+  const base::Time recent_time_limit = base::Time::Now() - base::Days(2);
+  FeedItemIndex<mojom::Article> article_index(std::move(articles),
+                                              recent_time_limit, FromArticle);
+  FeedItemIndex<mojom::PromotedArticle> promoted_article_index(
+      std::move(promoted_articles), recent_time_limit, FromPromotedArticle);
+  FeedItemIndex<mojom::Deal> deal_index(std::move(deals), recent_time_limit,
+                                        FromDeal);
   // Get first headline
-  std::list<mojom::ArticlePtr>::iterator featured_article_it;
-  for (featured_article_it = articles.begin();
-       featured_article_it != articles.end(); featured_article_it++) {
-    if (featured_article_it->get()->data->category_name == "Top News") {
-      break;
-    }
-  }
-  if (featured_article_it != articles.end()) {
-    auto item = *std::make_move_iterator(featured_article_it);
-    auto article = mojom::FeedItem::NewArticle(std::move(item));
-    feed->featured_item = std::move(article);
-    articles.erase(featured_article_it);
+  std::vector<mojom::FeedItemPtr> featured_items;
+  if (article_index.TakeFromCategory("Top News", 1u, &featured_items)) {
+    feed->featured_item = std::move(featured_items.front());
   }
   // Generate as many pages of content as possible
   // Make the pages
@@ -379,7 +450,7 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
   auto category_it = category_names_by_priority.begin();
   auto deal_category_it = deal_category_names_by_priority.begin();
   while (cur_page++ < max_pages) {
-    if (articles.size() == 0) {
+    if (article_index.size() == 0) {
       // No more pages of content
       break;
     }
@@ -393,7 +464,7 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
     for (auto card_type : page_content_order) {
       auto feed_page_item = mojom::FeedPageItem::New();
       feed_page_item->card_type = card_type;
-      BuildFeedPageItem(&articles, &promoted_articles, &deals,
+      BuildFeedPageItem(&article_index, &promoted_article_index, &deal_index,
                         deal_category_name, article_category_name, false,
                         &feed_page_item);
       feed_page->items.push_back(std::move(feed_page_item));
@@ -401,7 +472,7 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
     for (auto card_type : random_content_order) {
       auto feed_page_item = mojom::FeedPageItem::New();
       feed_page_item->card_type = card_type;
-      BuildFeedPageItem(&articles, &promoted_articles, &deals,
+      BuildFeedPageItem(&article_index, &promoted_article_index, &deal_index,
                         deal_category_name, article_category_name, true,
                         &feed_page_item);
       feed_page->items.push_back(std::move(feed_page_item));
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "brave/components/brave_today/browser/feed_building.h"
 #include "brave/components/brave_today/browser/feed_parsing.h"
@@ -112,6 +113,28 @@ void PopulatePublishers(Publishers* publisher_list) {
                                    std::move(publisher3));
 }
 
+std::vector<mojom::FeedItemPtr> GenerateLargeFeed(size_t count) {
+  const char* const kCategories[] = {"Top News", "Technology", "Business",
+                                     "Sports", "Science"};
+  const char* const kPublisherIds[] = {"111", "222", "333"};
+  std::vector<mojom::FeedItemPtr> feed_items;
+  for (size_t i = 0; i < count; i++) {
+    const std::string index = base::NumberToString(i);
+    feed_items.push_back(mojom::FeedItem::NewArticle(
+        mojom::Article::New(mojom::FeedItemMetadata::New(
+            kCategories[i % std::size(kCategories)],
+            base::Time::Now() - base::Hours(i % 96), "Title " + index,
+            "Description " + index,
+            GURL("https://www.example.com/article/" + index), index,
+            mojom::Image::NewPaddedImageUrl(
+                GURL("https://pcdn.brave.com/brave-today/cache/" + index +
+                     ".jpg.pad")),
+            kPublisherIds[i % std::size(kPublisherIds)], "", (i * 7919) % 1000,
+            "an hour ago"))));
+  }
+  return feed_items;
+}
+
 }  // namespace
 
 TEST(BraveNewsFeedBuilding, BuildFeed) {
@@ -247,4 +270,31 @@ TEST(BraveNewsFeedBuilding, IncludesUserEnabledItems) {
   ASSERT_TRUE(ShouldDisplayFeedItem(feed_item, &publisher_list));
 }
 
+TEST(BraveNewsFeedBuilding, BuildLargeFeed) {
+  Publishers publisher_list;
+  PopulatePublishers(&publisher_list);
+  std::unordered_set<std::string> history_hosts = {"www.example.com"};
+
+  constexpr size_t kFeedItemCount = 10000;
+  std::vector<mojom::FeedItemPtr> feed_items =
+      GenerateLargeFeed(kFeedItemCount);
+
+  mojom::Feed feed;
+  ASSERT_TRUE(BuildFeed(feed_items, history_hosts, &publisher_list, &feed));
+
+  // Every article is placed exactly once.
+  ASSERT_TRUE(feed.featured_item);
+  size_t article_count = 1u;
+  for (const auto& page : feed.pages) {
+    for (const auto& page_item : page->items) {
+      for (const auto& item : page_item->items) {
+        if (item->is_article()) {
+          article_count++;
+        }
+      }
+    }
+  }
+  EXPECT_EQ(article_count, kFeedItemCount);
+}
+
 }  // namespace brave_news
@@ -15,6 +15,8 @@
 #include "base/bind.h"
 #include "base/callback_forward.h"
 #include "base/one_shot_event.h"
+#include "base/task/task_traits.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/direct_feed_controller.h"
@@ -33,6 +35,17 @@ namespace {
 
 const char kEtagHeaderKey[] = "etag";
 
+mojom::FeedPtr BuildFeedInBackground(
+    FeedItems feed_items,
+    std::unordered_set<std::string> history_hosts,
+    Publishers publishers) {
+  auto feed = mojom::Feed::New();
+  if (!BuildFeed(feed_items, history_hosts, &publishers, feed.get())) {
+    VLOG(1) << "ParseFeed reported failure.";
+  }
+  return feed;
+}
+
 GURL GetFeedUrl() {
   GURL feed_url("https://" + brave_today::GetHostname() + "/brave-today/feed." +
                 brave_today::GetRegionUrlPart() + "json");
@@ -148,16 +161,20 @@ void FeedController::EnsureFeedIsUpdating() {
                       history_hosts.insert(host);
                     }
                     VLOG(1) << "history hosts # " << history_hosts.size();
-                    // Parse directly to in-memory property
-                    controller->ResetFeed();
-                    std::vector<mojom::FeedItemPtr> feed_items;
-                    if (BuildFeed(all_feed_items, history_hosts, &publishers,
-                                  &controller->current_feed_)) {
-                    } else {
-                      VLOG(1) << "ParseFeed reported failure.";
-                    }
-                    // Let any callbacks know that the data is ready or errored.
-                    controller->NotifyUpdateDone();
+                    // Scoring, sorting and paging every feed item is too
+                    // expensive for the UI thread, so build the feed in the
+                    // background.
+                    base::ThreadPool::PostTaskAndReplyWithResult(
+                        FROM_HERE,
+                        {base::TaskPriority::USER_VISIBLE,
+                         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+                        base::BindOnce(&BuildFeedInBackground,
+                                       std::move(all_feed_items),
+                                       std::move(history_hosts),
+                                       std::move(publishers)),
+                        base::BindOnce(&FeedController::OnFeedBuilt,
+                                       controller->weak_ptr_factory_
+                                           .GetWeakPtr()));
                   },
                   base::Unretained(controller), std::move(all_feed_items),
                   std::move(publishers));
@@ -290,6 +307,16 @@ void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
   EnsureFeedIsUpdating();
 }
 
+void FeedController::OnFeedBuilt(mojom::FeedPtr feed) {
+  // Move the built feed to the in-memory property
+  ResetFeed();
+  current_feed_.featured_item = std::move(feed->featured_item);
+  current_feed_.hash = std::move(feed->hash);
+  current_feed_.pages = std::move(feed->pages);
+  // Let any callbacks know that the data is ready or errored.
+  NotifyUpdateDone();
+}
+
 void FeedController::ResetFeed() {
   current_feed_.featured_item = nullptr;
   current_feed_.hash = "";
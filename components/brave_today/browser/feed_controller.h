@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/scoped_observation.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
@@ -66,6 +67,7 @@ class FeedController : public PublishersController::Observer {
  private:
   void FetchCombinedFeed(GetFeedItemsCallback callback);
   void GetOrFetchFeed(base::OnceClosure callback);
+  void OnFeedBuilt(mojom::FeedPtr feed);
   void ResetFeed();
   void NotifyUpdateDone();
 
@@ -86,6 +88,8 @@ class FeedController : public PublishersController::Observer {
   mojom::Feed current_feed_;
   std::string current_feed_etag_;
   bool is_update_in_progress_ = false;
+
+  base::WeakPtrFactory<FeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
@@ -642,6 +642,9 @@ constexpr char kAffiliateAddress[] =
     "0xbd9420A98a7Bd6B89765e5715e169481602D9c3d";
 
 constexpr int64_t kBlockTrackerDefaultTimeInSeconds = 20;
+// Polling interval right after a transaction was submitted, backing off to
+// the default one while waiting for it to be mined.
+constexpr int64_t kBlockTrackerSubmittedTxTimeInSeconds = 4;
 
 constexpr char kPolygonMainnetEndpoint[] = "https://mainnet-polygon.brave.com/";
 
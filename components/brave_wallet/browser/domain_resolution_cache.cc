@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+template <class ResultType>
+DomainResolutionCache<ResultType>::DomainResolutionCache()
+    : results_(kMaxSize) {}
+
+template <class ResultType>
+DomainResolutionCache<ResultType>::~DomainResolutionCache() = default;
+
+template <class ResultType>
+bool DomainResolutionCache<ResultType>::AddCallback(const std::string& domain,
+                                                    CallbackType callback) {
+  auto cached_result = results_.Get(domain);
+  if (cached_result != results_.end()) {
+    if (base::TimeTicks::Now() < cached_result->second.expiration_time) {
+      std::move(callback).Run(cached_result->second.result,
+                              mojom::ProviderError::kSuccess, "");
+      return false;
+    }
+    results_.Erase(cached_result);
+  }
+
+  auto& callbacks = pending_callbacks_[domain];
+  callbacks.push_back(std::move(callback));
+  return callbacks.size() == 1;
+}
+
+template <class ResultType>
+typename DomainResolutionCache<ResultType>::CallbackType
+DomainResolutionCache<ResultType>::GetResolveCallback(
+    const std::string& domain) {
+  return base::BindOnce(&DomainResolutionCache::SetResult,
+                        weak_ptr_factory_.GetWeakPtr(), domain);
+}
+
+template <class ResultType>
+void DomainResolutionCache<ResultType>::SetResult(
+    const std::string& domain,
+    const ResultType& result,
+    mojom::ProviderError error,
+    const std::string& error_message) {
+  if (error == mojom::ProviderError::kSuccess) {
+    const bool has_result = result != ResultType();
+    results_.Put(domain,
+                 {result, base::TimeTicks::Now() +
+                              (has_result ? kResultTTL : kNoResultTTL)});
+  }
+
+  auto pending = pending_callbacks_.find(domain);
+  if (pending == pending_callbacks_.end())
+    return;
+  auto callbacks = std::move(pending->second);
+  pending_callbacks_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(result, error, error_message);
+}
+
+template <class ResultType>
+void DomainResolutionCache<ResultType>::Clear() {
+  results_.Clear();
+}
+
+template class DomainResolutionCache<std::string>;
+template class DomainResolutionCache<GURL>;
+
+}  // namespace brave_wallet
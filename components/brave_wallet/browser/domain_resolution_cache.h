@@ -0,0 +1,74 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_DOMAIN_RESOLUTION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_DOMAIN_RESOLUTION_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+
+namespace brave_wallet {
+
+// Keeps the results of ENS and Unstoppable Domains lookups for a while and
+// queues the callbacks of lookups which are already in flight, so repeated and
+// concurrent lookups of the same domain cost a single round of requests.
+// Only successful lookups are cached, the ones without a result for a shorter
+// time than the ones with a result.
+template <class ResultType>
+class DomainResolutionCache {
+ public:
+  using CallbackType = base::OnceCallback<
+      void(const ResultType&, mojom::ProviderError, const std::string&)>;
+
+  static constexpr size_t kMaxSize = 100;
+  static constexpr base::TimeDelta kResultTTL = base::Minutes(5);
+  static constexpr base::TimeDelta kNoResultTTL = base::Minutes(1);
+
+  DomainResolutionCache();
+  ~DomainResolutionCache();
+  DomainResolutionCache(const DomainResolutionCache&) = delete;
+  DomainResolutionCache& operator=(const DomainResolutionCache&) = delete;
+
+  // Runs |callback| right away if there is a cached result for |domain|,
+  // otherwise queues it until the result is set. Returns true if no lookup of
+  // |domain| is in flight yet, so the caller has to start one.
+  bool AddCallback(const std::string& domain, CallbackType callback);
+
+  // Returns a callback which sets the result of the lookup of |domain|.
+  CallbackType GetResolveCallback(const std::string& domain);
+
+  // Runs the queued callbacks of |domain| and caches the result.
+  void SetResult(const std::string& domain,
+                 const ResultType& result,
+                 mojom::ProviderError error,
+                 const std::string& error_message);
+
+  // Drops the cached results, lookups in flight are not affected.
+  void Clear();
+
+  size_t size() const { return results_.size(); }
+
+ private:
+  struct CachedResult {
+    ResultType result;
+    base::TimeTicks expiration_time;
+  };
+
+  base::LRUCache<std::string, CachedResult> results_;
+  // domain -> callbacks of the lookup in flight.
+  base::flat_map<std::string, std::vector<CallbackType>> pending_callbacks_;
+  base::WeakPtrFactory<DomainResolutionCache> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_DOMAIN_RESOLUTION_CACHE_H_
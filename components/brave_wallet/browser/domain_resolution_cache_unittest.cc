@@ -0,0 +1,160 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/mock_callback.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using testing::_;
+
+namespace brave_wallet {
+
+class DomainResolutionCacheUnitTest : public testing::Test {
+ public:
+  using Cache = DomainResolutionCache<std::string>;
+  using CallbackType = Cache::CallbackType;
+
+  static constexpr char kDomain[] = "brantly.eth";
+  static constexpr char kAddress[] =
+      "0x983110309620D911731Ac0932219af06091b6744";
+
+  Cache& cache() { return cache_; }
+
+  void FastForwardBy(base::TimeDelta delta) {
+    task_environment_.FastForwardBy(delta);
+  }
+
+ private:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  Cache cache_;
+};
+
+TEST_F(DomainResolutionCacheUnitTest, CoalesceCallbacks) {
+  base::MockCallback<CallbackType> cb1;
+  base::MockCallback<CallbackType> cb2;
+  EXPECT_CALL(cb1, Run(_, _, _)).Times(0);
+  EXPECT_CALL(cb2, Run(_, _, _)).Times(0);
+
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb1.Get()));
+  // The lookup is in flight already.
+  EXPECT_FALSE(cache().AddCallback(kDomain, cb2.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb1);
+  testing::Mock::VerifyAndClearExpectations(&cb2);
+
+  EXPECT_CALL(cb1, Run(kAddress, mojom::ProviderError::kSuccess, ""));
+  EXPECT_CALL(cb2, Run(kAddress, mojom::ProviderError::kSuccess, ""));
+  cache().GetResolveCallback(kDomain).Run(kAddress,
+                                          mojom::ProviderError::kSuccess, "");
+  testing::Mock::VerifyAndClearExpectations(&cb1);
+  testing::Mock::VerifyAndClearExpectations(&cb2);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, CacheResult) {
+  base::MockCallback<CallbackType> cb;
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  EXPECT_CALL(cb, Run(kAddress, mojom::ProviderError::kSuccess, ""));
+  cache().SetResult(kDomain, kAddress, mojom::ProviderError::kSuccess, "");
+  testing::Mock::VerifyAndClearExpectations(&cb);
+
+  // Served from the cache until the result expires.
+  FastForwardBy(Cache::kResultTTL - base::Seconds(1));
+  EXPECT_CALL(cb, Run(kAddress, mojom::ProviderError::kSuccess, ""));
+  EXPECT_FALSE(cache().AddCallback(kDomain, cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+
+  FastForwardBy(base::Seconds(1));
+  EXPECT_CALL(cb, Run(_, _, _)).Times(0);
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+  EXPECT_EQ(0u, cache().size());
+}
+
+TEST_F(DomainResolutionCacheUnitTest, CacheNoResult) {
+  base::MockCallback<CallbackType> cb;
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  EXPECT_CALL(cb, Run("", mojom::ProviderError::kSuccess, ""));
+  cache().SetResult(kDomain, "", mojom::ProviderError::kSuccess, "");
+  testing::Mock::VerifyAndClearExpectations(&cb);
+
+  FastForwardBy(Cache::kNoResultTTL - base::Seconds(1));
+  EXPECT_CALL(cb, Run("", mojom::ProviderError::kSuccess, ""));
+  EXPECT_FALSE(cache().AddCallback(kDomain, cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+
+  FastForwardBy(base::Seconds(1));
+  EXPECT_CALL(cb, Run(_, _, _)).Times(0);
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, ErrorsAreNotCached) {
+  base::MockCallback<CallbackType> cb;
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  EXPECT_CALL(cb, Run("", mojom::ProviderError::kInternalError, "error"));
+  cache().SetResult(kDomain, "", mojom::ProviderError::kInternalError,
+                    "error");
+  testing::Mock::VerifyAndClearExpectations(&cb);
+  EXPECT_EQ(0u, cache().size());
+
+  EXPECT_CALL(cb, Run(_, _, _)).Times(0);
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, Clear) {
+  cache().SetResult(kDomain, kAddress, mojom::ProviderError::kSuccess, "");
+  EXPECT_EQ(1u, cache().size());
+  cache().Clear();
+  EXPECT_EQ(0u, cache().size());
+
+  base::MockCallback<CallbackType> cb;
+  EXPECT_CALL(cb, Run(_, _, _)).Times(0);
+  EXPECT_TRUE(cache().AddCallback(kDomain, cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, Bounded) {
+  for (size_t i = 0; i < Cache::kMaxSize * 2; ++i) {
+    cache().SetResult(base::NumberToString(i) + ".eth", kAddress,
+                      mojom::ProviderError::kSuccess, "");
+  }
+  EXPECT_EQ(Cache::kMaxSize, cache().size());
+
+  // The least recently used results are evicted first.
+  base::MockCallback<CallbackType> cb;
+  EXPECT_CALL(cb, Run(_, _, _)).Times(0);
+  EXPECT_TRUE(cache().AddCallback("0.eth", cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+  EXPECT_CALL(cb, Run(kAddress, mojom::ProviderError::kSuccess, ""));
+  EXPECT_FALSE(cache().AddCallback(
+      base::NumberToString(Cache::kMaxSize * 2 - 1) + ".eth", cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, GURLResult) {
+  DomainResolutionCache<GURL> cache;
+  base::MockCallback<DomainResolutionCache<GURL>::CallbackType> cb;
+  EXPECT_TRUE(cache.AddCallback("brave.crypto", cb.Get()));
+  EXPECT_CALL(cb, Run(GURL("https://brave.com"),
+                      mojom::ProviderError::kSuccess, ""));
+  cache.SetResult("brave.crypto", GURL("https://brave.com"),
+                  mojom::ProviderError::kSuccess, "");
+  testing::Mock::VerifyAndClearExpectations(&cb);
+
+  EXPECT_CALL(cb, Run(GURL("https://brave.com"),
+                      mojom::ProviderError::kSuccess, ""));
+  EXPECT_FALSE(cache.AddCallback("brave.crypto", cb.Get()));
+  testing::Mock::VerifyAndClearExpectations(&cb);
+}
+
+}  // namespace brave_wallet
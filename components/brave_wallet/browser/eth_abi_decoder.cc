@@ -8,6 +8,7 @@
 #include <limits>
 #include <map>
 #include <tuple>
+#include <utility>
 
 #include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
@@ -37,61 +38,68 @@
 namespace brave_wallet {
 
 namespace {
-// GetArgFromData extracts a 32-byte wide hex string from the calldata at the
-// specified offset. The parsed value is NOT prefixed by "0x".
-absl::optional<std::string> GetArgFromData(const std::vector<uint8_t>& input,
-                                           size_t offset) {
+
+// AppendHexLower appends the lower case hex representation of |bytes| to
+// |output|, without a "0x" prefix.
+void AppendHexLower(base::span<const uint8_t> bytes, std::string* output) {
+  static constexpr char kHexChars[] = "0123456789abcdef";
+  for (uint8_t byte : bytes) {
+    output->push_back(kHexChars[byte >> 4]);
+    output->push_back(kHexChars[byte & 0xf]);
+  }
+}
+
+// ToPrefixedHex serializes |bytes| as a hex string prefixed by "0x".
+std::string ToPrefixedHex(base::span<const uint8_t> bytes) {
+  std::string output;
+  output.reserve(2 + bytes.size() * 2);
+  output.append("0x");
+  AppendHexLower(bytes, &output);
+  return output;
+}
+
+// GetArgFromData returns a view of the 32-byte wide argument in the calldata
+// at the specified offset.
+absl::optional<base::span<const uint8_t>> GetArgFromData(
+    base::span<const uint8_t> input,
+    size_t offset) {
   if (offset > input.size() || input.size() - offset < 32)
     return absl::nullopt;
 
-  return HexEncodeLower(input.data() + offset, 32);
+  return input.subspan(offset, 32);
 }
 
-// GetAddressFromData extracts an Ethereum address from the calldata at the
-// specified index. The address type is static and 32-bytes wide, but we
+// GetAddressFromData returns a view of an Ethereum address in the calldata at
+// the specified offset. The address type is static and 32-bytes wide, but we
 // only consider the last 20 bytes, discarding the leading 12 bytes of
 // 0-padded chars.
 //
 // In the future, addresses in Ethereum may become 32 bytes long:
 // https://ethereum-magicians.org/t/increasing-address-size-from-20-to-32-bytes
-//
-// The parsed address value is prefixed by "0x".
-absl::optional<std::string> GetAddressFromData(
-    const std::vector<uint8_t>& input,
+absl::optional<base::span<const uint8_t>> GetAddressFromData(
+    base::span<const uint8_t> input,
     size_t offset) {
-  if (offset > input.size() || input.size() - offset < 32)
+  auto arg = GetArgFromData(input, offset);
+  if (!arg)
     return absl::nullopt;
 
-  return "0x" + HexEncodeLower(input.data() + offset + 12, 20);
+  return arg->subspan(12);
 }
 
 // GetUint256FromData extracts a 32-byte wide uint256 value from the
 // calldata at the specified offset.
-absl::optional<uint256_t> GetUint256FromData(const std::vector<uint8_t>& input,
+absl::optional<uint256_t> GetUint256FromData(base::span<const uint8_t> input,
                                              size_t offset) {
-  auto value = GetArgFromData(input, offset);
-  if (!value)
+  auto arg = GetArgFromData(input, offset);
+  if (!arg)
     return absl::nullopt;
 
-  uint256_t arg;
-  if (!HexValueToUint256("0x" + *value, &arg))
-    return absl::nullopt;
-  return arg;
-}
-
-// GetUint256FromData extracts a 32-byte wide uint256 hex value from the
-// calldata at the specified offset.
-//
-// The parsed uint256 value is serialized as a compact hex string (without)
-// leading 0s, and prefixed by "0x".
-absl::optional<std::string> GetUint256HexFromData(
-    const std::vector<uint8_t>& input,
-    size_t offset) {
-  auto arg_uint256 = GetUint256FromData(input, offset);
-  if (!arg_uint256)
-    return absl::nullopt;
-
-  return Uint256ValueToHex(*arg_uint256);
+  uint256_t value = 0;
+  for (uint8_t byte : *arg) {
+    value <<= 8;
+    value += byte;
+  }
+  return value;
 }
 
 // GetSizeFromData extracts a 32-byte wide size_t value from the calldata
@@ -100,47 +108,48 @@ absl::optional<std::string> GetUint256HexFromData(
 // Using this function to extract an integer outside the range of size_t is
 // considered an error. Ideal candidates are calldata tail references, length
 // of dynamic types, etc.
-absl::optional<size_t> GetSizeFromData(const std::vector<uint8_t>& input,
+absl::optional<size_t> GetSizeFromData(base::span<const uint8_t> input,
                                        size_t offset) {
-  auto value = GetUint256FromData(input, offset);
-  if (!value)
+  auto arg = GetArgFromData(input, offset);
+  if (!arg)
     return absl::nullopt;
 
   // Since we use value as an array index, we need to cast the type to
   // something that can be used as an index, viz. size_t. To prevent runtime
   // errors, we make sure the value is within safe limits of size_t.
-  if (*value > std::numeric_limits<size_t>::max())
-    return absl::nullopt;
-
-  return static_cast<size_t>(*value);
+  size_t value = 0;
+  for (uint8_t byte : *arg) {
+    if (value > (std::numeric_limits<size_t>::max() >> 8))
+      return absl::nullopt;
+    value = (value << 8) | byte;
+  }
+  return value;
 }
 
 // GetBoolFromData extracts a 32-byte wide boolean value from the
 // calldata at the specified offset.
-//
-// The parsed bool value is serialized as "true" or "false" strings.
-absl::optional<std::string> GetBoolFromData(const std::vector<uint8_t>& input,
-                                            size_t offset) {
-  auto value = GetUint256FromData(input, offset);
-  if (!value)
+absl::optional<bool> GetBoolFromData(base::span<const uint8_t> input,
+                                     size_t offset) {
+  auto arg = GetArgFromData(input, offset);
+  if (!arg)
     return absl::nullopt;
 
-  if (value == 0)
-    return "false";
-  else if (value == 1)
-    return "true";
+  for (uint8_t byte : arg->first(31)) {
+    if (byte != 0)
+      return absl::nullopt;
+  }
+  if (arg->back() > 1)
+    return absl::nullopt;
 
-  return absl::nullopt;
+  return arg->back() == 1;
 }
 
-// GetBytesHexFromData extracts a bytes value from the calldata at the
+// GetBytesFromData returns a view of a bytes value in the calldata at the
 // specified offset using head-tail encoding mechanism. bytes are packed
 // tightly in chunks of 32 bytes, with the first 32 bytes encoding the length,
 // followed by the actual content.
-//
-// The parsed bytearray is serialized as a hex string prefixed by "0x".
-absl::optional<std::string> GetBytesHexFromData(
-    const std::vector<uint8_t>& input,
+absl::optional<base::span<const uint8_t>> GetBytesFromData(
+    base::span<const uint8_t> input,
     size_t offset) {
   auto pointer = GetSizeFromData(input, offset);
   if (!pointer)
@@ -150,19 +159,22 @@ absl::optional<std::string> GetBytesHexFromData(
   if (!bytes_len)
     return absl::nullopt;
 
-  if (input.size() < static_cast<uint256_t>(*pointer) + 32 + *bytes_len)
+  // The length was read from the calldata, so at least 32 bytes follow the
+  // pointer.
+  const size_t bytes_offset = *pointer + 32;
+  if (*bytes_len > input.size() - bytes_offset)
     return absl::nullopt;
-  return "0x" + HexEncodeLower(input.data() + *pointer + 32, *bytes_len);
+
+  return input.subspan(bytes_offset, *bytes_len);
 }
 
-// GetAddressArrayFromData parses a calldata sequence to extract a dynamic
-// array of addresses at the specified offset using head-tail encoding
-// mechanism. The encoding is similar to bytes, with the first 32 bytes
-// representing the number of elements in the array, followed by each element.
-//
-// The parsed data is joined together into a hex string prefixed by "0x".
-absl::optional<std::string> GetAddressArrayFromData(
-    const std::vector<uint8_t>& input,
+// GetAddressArrayFromData returns a view of the elements of a dynamic array
+// of addresses in the calldata at the specified offset using head-tail
+// encoding mechanism. The encoding is similar to bytes, with the first 32
+// bytes representing the number of elements in the array, followed by each
+// 32-byte wide element.
+absl::optional<base::span<const uint8_t>> GetAddressArrayFromData(
+    base::span<const uint8_t> input,
     size_t offset) {
   auto pointer = GetSizeFromData(input, offset);
   if (!pointer)
@@ -172,17 +184,23 @@ absl::optional<std::string> GetAddressArrayFromData(
   if (!array_len)
     return absl::nullopt;
 
-  size_t array_offset = *pointer + 32;
-  std::string arg = "0x";
-  for (size_t i = 0; i < *array_len; i++) {
-    auto value = GetAddressFromData(input, array_offset);
-    if (!value)
-      return absl::nullopt;
-    base::StrAppend(&arg, {value->substr(2)});
-    array_offset += 32;
-  }
+  const size_t array_offset = *pointer + 32;
+  if (*array_len > (input.size() - array_offset) / 32)
+    return absl::nullopt;
+
+  return input.subspan(array_offset, *array_len * 32);
+}
 
-  return arg;
+// AddressArrayToHex joins the addresses of an array returned by
+// GetAddressArrayFromData into a hex string prefixed by "0x".
+std::string AddressArrayToHex(base::span<const uint8_t> elements) {
+  std::string output;
+  output.reserve(2 + elements.size() / 32 * 40);
+  output.append("0x");
+  for (size_t offset = 0; offset < elements.size(); offset += 32) {
+    AppendHexLower(elements.subspan(offset + 12, 20), &output);
+  }
+  return output;
 }
 
 }  // namespace
@@ -245,28 +263,41 @@ absl::optional<std::vector<std::string>> UniswapEncodedPathDecode(
 absl::optional<std::tuple<std::vector<std::string>,   // tx_params
                           std::vector<std::string>>>  // tx_args
 ABIDecode(const std::vector<std::string>& types,
-          const std::vector<uint8_t>& data) {
+          base::span<const uint8_t> data) {
   size_t offset = 0;
   size_t calldata_tail = 0;
   std::vector<std::string> tx_params;
   std::vector<std::string> tx_args;
+  tx_params.reserve(types.size());
+  tx_args.reserve(types.size());
 
+  // Arguments are decoded into views of the calldata, and only serialized
+  // into hex strings once they are known to be valid.
   for (const auto& type : types) {
     absl::optional<std::string> value;
     if (type == "address") {
-      value = GetAddressFromData(data, offset);
+      if (auto address = GetAddressFromData(data, offset))
+        value = ToPrefixedHex(*address);
     } else if (type == "uint256") {
-      value = GetUint256HexFromData(data, offset);
+      if (auto arg_uint256 = GetUint256FromData(data, offset))
+        value = Uint256ValueToHex(*arg_uint256);
     } else if (type == "bool") {
-      value = GetBoolFromData(data, offset);
+      if (auto arg_bool = GetBoolFromData(data, offset))
+        value = *arg_bool ? "true" : "false";
     } else if (type == "bytes") {
-      value = GetBytesHexFromData(data, offset);
+      if (auto bytes = GetBytesFromData(data, offset))
+        value = ToPrefixedHex(*bytes);
     } else if (type == "address[]") {
-      value = GetAddressArrayFromData(data, offset);
+      if (auto elements = GetAddressArrayFromData(data, offset))
+        value = AddressArrayToHex(*elements);
     } else {
       // For unknown/unsupported types, we only extract 32-bytes. In case of
-      // dynamic types, this value is a calldata reference.
-      value = GetArgFromData(data, offset);
+      // dynamic types, this value is a calldata reference. The value is NOT
+      // prefixed by "0x".
+      if (auto arg = GetArgFromData(data, offset)) {
+        value.emplace();
+        AppendHexLower(*arg, &*value);
+      }
     }
 
     if (!value)
@@ -285,7 +316,7 @@ ABIDecode(const std::vector<std::string>& types,
 
     offset += 32;
 
-    tx_args.push_back(*value);
+    tx_args.push_back(std::move(*value));
     tx_params.push_back(type);
   }
 
@@ -293,7 +324,7 @@ ABIDecode(const std::vector<std::string>& types,
   if (offset != calldata_tail && offset < data.size())
     return absl::nullopt;
 
-  return std::make_tuple(tx_params, tx_args);
+  return std::make_tuple(std::move(tx_params), std::move(tx_args));
 }
 
 }  // namespace brave_wallet
@@ -9,7 +9,9 @@
 #include <string>
 #include <tuple>
 #include <vector>
-#include "base/values.h"
+
+#include "base/containers/span.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -19,7 +21,7 @@ absl::optional<std::vector<std::string>> UniswapEncodedPathDecode(
 absl::optional<std::tuple<std::vector<std::string>,   // tx_params
                           std::vector<std::string>>>  // tx_args
 ABIDecode(const std::vector<std::string>& types,
-          const std::vector<uint8_t>& data);
+          base::span<const uint8_t> data);
 
 }  // namespace brave_wallet
 
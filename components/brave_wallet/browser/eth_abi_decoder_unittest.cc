@@ -5,7 +5,9 @@
 
 #include "brave/components/brave_wallet/browser/eth_abi_decoder.h"
 
+#include <limits>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
@@ -14,6 +16,28 @@
 
 namespace brave_wallet {
 
+namespace {
+
+// Returns a 32-byte wide word holding |value|.
+std::vector<uint8_t> Word(size_t value) {
+  std::vector<uint8_t> word(32, 0);
+  for (size_t i = 0; i < sizeof(size_t); i++) {
+    word[31 - i] = static_cast<uint8_t>(value >> (i * 8));
+  }
+  return word;
+}
+
+std::vector<uint8_t> Words(const std::vector<size_t>& values) {
+  std::vector<uint8_t> data;
+  for (size_t value : values) {
+    const std::vector<uint8_t> word = Word(value);
+    data.insert(data.end(), word.begin(), word.end());
+  }
+  return data;
+}
+
+}  // namespace
+
 TEST(EthABIDecoderTest, ABIDecodeAddress) {
   std::vector<std::string> tx_params;
   std::vector<std::string> tx_args;
@@ -341,4 +365,74 @@ TEST(EthABIDecoderTest, UniswapEncodedPathDecodeInvalid) {
       "deadbeef"));                                 // Bogus data
 }
 
+TEST(EthABIDecoderTest, ABIDecodeLongAddressArray) {
+  // Swap through a long token path, as decoded for sellToUniswap.
+  constexpr size_t kPathLength = 1000;
+  std::vector<size_t> words = {4 * 32, 1000, 2000, 1, kPathLength};
+  for (size_t i = 0; i < kPathLength; i++) {
+    words.push_back(i + 1);
+  }
+  auto decoded = ABIDecode({"address[]", "uint256", "uint256", "bool"},
+                           Words(words));
+  ASSERT_NE(decoded, absl::nullopt);
+
+  std::vector<std::string> tx_args;
+  std::tie(std::ignore, tx_args) = *decoded;
+  ASSERT_EQ(tx_args.size(), 4UL);
+  ASSERT_EQ(tx_args[0].size(), 2 + kPathLength * 40);
+  EXPECT_EQ(tx_args[0].substr(0, 42),
+            "0x0000000000000000000000000000000000000001");
+  EXPECT_EQ(tx_args[0].substr(tx_args[0].size() - 40),
+            "00000000000000000000000000000000000003e8");
+  EXPECT_EQ(tx_args[1], "0x3e8");
+  EXPECT_EQ(tx_args[2], "0x7d0");
+  EXPECT_EQ(tx_args[3], "true");
+}
+
+TEST(EthABIDecoderTest, ABIDecodeLargeBytes) {
+  // Multicall style calldata carrying a large bytes argument.
+  constexpr size_t kBytesLength = 64 * 1024;
+  std::vector<uint8_t> data = Words({3 * 32, 1, 2, kBytesLength});
+  data.resize(data.size() + kBytesLength, 0xab);
+  auto decoded = ABIDecode({"bytes", "uint256", "address"}, data);
+  ASSERT_NE(decoded, absl::nullopt);
+
+  std::vector<std::string> tx_args;
+  std::tie(std::ignore, tx_args) = *decoded;
+  ASSERT_EQ(tx_args.size(), 3UL);
+  std::string expected_bytes = "0x";
+  for (size_t i = 0; i < kBytesLength; i++) {
+    expected_bytes += "ab";
+  }
+  EXPECT_EQ(tx_args[0], expected_bytes);
+  EXPECT_EQ(tx_args[1], "0x1");
+  EXPECT_EQ(tx_args[2], "0x0000000000000000000000000000000000000002");
+}
+
+TEST(EthABIDecoderTest, ABIDecodeOutOfBoundsReferences) {
+  // Array with fewer elements than its length.
+  EXPECT_FALSE(ABIDecode({"address[]"}, Words({32, 3, 1, 2})));
+  // Array reference past the end of the calldata.
+  EXPECT_FALSE(ABIDecode({"address[]"}, Words({1000, 1, 1})));
+  // Bytes reference past the end of the calldata.
+  EXPECT_FALSE(ABIDecode({"bytes"}, Words({1000, 1, 1})));
+  // Bytes length which overflows the offset of its content.
+  EXPECT_FALSE(ABIDecode(
+      {"bytes"}, Words({32, std::numeric_limits<size_t>::max(), 1})));
+
+  // Bytes length which does not fit in size_t.
+  std::vector<uint8_t> data = Word(32);
+  data.resize(data.size() + 32, 0xff);
+  EXPECT_FALSE(ABIDecode({"bytes"}, data));
+}
+
+TEST(EthABIDecoderTest, ABIDecodeMisalignedCalldata) {
+  std::vector<uint8_t> data = Words({1, 2});
+  data.push_back(0);
+  EXPECT_FALSE(ABIDecode({"uint256", "uint256"}, data));
+
+  data.resize(data.size() - 2);
+  EXPECT_FALSE(ABIDecode({"uint256", "uint256"}, data));
+}
+
 }  // namespace brave_wallet
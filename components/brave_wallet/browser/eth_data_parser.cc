@@ -8,6 +8,7 @@
 #include <map>
 #include <tuple>
 
+#include "base/containers/span.h"
 #include "base/strings/strcat.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/eth_abi_decoder.h"
@@ -48,7 +49,7 @@ GetTransactionInfoFromData(const std::vector<uint8_t>& data) {
   }
 
   std::string selector = "0x" + HexEncodeLower(data.data(), 4);
-  std::vector<uint8_t> calldata(data.begin() + 4, data.end());
+  const auto calldata = base::make_span(data).subspan(4);
   if (selector == kERC20TransferSelector) {
     auto decoded = ABIDecode({"address", "uint256"}, calldata);
     if (!decoded)
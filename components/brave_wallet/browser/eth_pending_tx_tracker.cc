@@ -5,8 +5,10 @@
 
 #include "brave/components/brave_wallet/browser/eth_pending_tx_tracker.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/synchronization/lock.h"
@@ -19,6 +21,13 @@
 
 namespace brave_wallet {
 
+namespace {
+
+// Maximum number of receipts looked up with a single JSON-RPC batch request.
+constexpr size_t kTxReceiptsBatchSize = 100;
+
+}  // namespace
+
 EthPendingTxTracker::EthPendingTxTracker(EthTxStateManager* tx_state_manager,
                                          JsonRpcService* json_rpc_service,
                                          EthNonceTracker* nonce_tracker)
@@ -35,16 +44,28 @@ bool EthPendingTxTracker::UpdatePendingTransactions(size_t* num_pending) {
 
   auto pending_transactions = tx_state_manager_->GetTransactionsByStatus(
       mojom::TransactionStatus::Submitted, absl::nullopt);
+  std::vector<std::string> ids;
+  std::vector<std::string> tx_hashes;
   for (const auto& pending_transaction : pending_transactions) {
     if (IsNonceTaken(static_cast<const EthTxMeta&>(*pending_transaction))) {
       DropTransaction(pending_transaction.get());
       continue;
     }
-    std::string id = pending_transaction->id();
-    json_rpc_service_->GetTransactionReceipt(
-        pending_transaction->tx_hash(),
-        base::BindOnce(&EthPendingTxTracker::OnGetTxReceipt,
-                       weak_factory_.GetWeakPtr(), std::move(id)));
+    ids.push_back(pending_transaction->id());
+    tx_hashes.push_back(pending_transaction->tx_hash());
+  }
+
+  // Look the receipts up with as few batch requests as possible, instead of
+  // one request per transaction.
+  for (size_t start = 0; start < ids.size(); start += kTxReceiptsBatchSize) {
+    const size_t end = std::min(ids.size(), start + kTxReceiptsBatchSize);
+    std::vector<std::string> batch_ids(ids.begin() + start, ids.begin() + end);
+    std::vector<std::string> batch_tx_hashes(tx_hashes.begin() + start,
+                                             tx_hashes.begin() + end);
+    json_rpc_service_->GetTransactionReceipts(
+        batch_tx_hashes,
+        base::BindOnce(&EthPendingTxTracker::OnGetTxReceipts,
+                       weak_factory_.GetWeakPtr(), std::move(batch_ids)));
   }
 
   nonce_lock->Release();
@@ -74,21 +95,31 @@ void EthPendingTxTracker::Reset() {
   dropped_blocks_counter_.clear();
 }
 
-void EthPendingTxTracker::OnGetTxReceipt(std::string id,
-                                         TransactionReceipt receipt,
-                                         mojom::ProviderError error,
-                                         const std::string& error_message) {
-  if (error != mojom::ProviderError::kSuccess)
+void EthPendingTxTracker::OnGetTxReceipts(
+    std::vector<std::string> ids,
+    std::vector<absl::optional<TransactionReceipt>> receipts,
+    mojom::ProviderError error,
+    const std::string& error_message) {
+  if (error != mojom::ProviderError::kSuccess || receipts.size() != ids.size())
     return;
   base::Lock* nonce_lock = nonce_tracker_->GetLock();
   if (!nonce_lock->Try())
     return;
 
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (receipts[i])
+      UpdateTxWithReceipt(ids[i], *receipts[i]);
+  }
+
+  nonce_lock->Release();
+}
+
+void EthPendingTxTracker::UpdateTxWithReceipt(
+    const std::string& id,
+    const TransactionReceipt& receipt) {
   std::unique_ptr<EthTxMeta> meta = tx_state_manager_->GetEthTx(id);
-  if (!meta) {
-    nonce_lock->Release();
+  if (!meta)
     return;
-  }
   if (receipt.status) {
     meta->set_tx_receipt(receipt);
     meta->set_status(mojom::TransactionStatus::Confirmed);
@@ -97,8 +128,6 @@ void EthPendingTxTracker::OnGetTxReceipt(std::string id,
   } else if (ShouldTxDropped(*meta)) {
     DropTransaction(meta.get());
   }
-
-  nonce_lock->Release();
 }
 
 void EthPendingTxTracker::OnGetNetworkNonce(std::string address,
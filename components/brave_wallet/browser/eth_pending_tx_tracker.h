@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_PENDING_TX_TRACKER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
@@ -14,6 +15,7 @@
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wallet/browser/eth_tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -40,10 +42,12 @@ class EthPendingTxTracker {
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, ShouldTxDropped);
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, DropTransaction);
 
-  void OnGetTxReceipt(std::string id,
-                      TransactionReceipt receipt,
-                      mojom::ProviderError error,
-                      const std::string& error_message);
+  void OnGetTxReceipts(std::vector<std::string> ids,
+                       std::vector<absl::optional<TransactionReceipt>> receipts,
+                       mojom::ProviderError error,
+                       const std::string& error_message);
+  void UpdateTxWithReceipt(const std::string& id,
+                           const TransactionReceipt& receipt);
   void OnGetNetworkNonce(std::string address,
                          uint256_t result,
                          mojom::ProviderError error,
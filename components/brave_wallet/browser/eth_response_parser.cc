@@ -5,8 +5,10 @@
 
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "base/json/json_reader.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/json_rpc_response_parser.h"
@@ -18,6 +20,72 @@ namespace brave_wallet {
 
 namespace eth {
 
+namespace {
+
+bool ParseTransactionReceiptResult(const base::Value& result,
+                                   TransactionReceipt* receipt) {
+  const base::DictionaryValue* result_dict = nullptr;
+  if (!result.GetAsDictionary(&result_dict))
+    return false;
+  DCHECK(result_dict);
+
+  if (!result_dict->GetString("transactionHash", &receipt->transaction_hash))
+    return false;
+  std::string transaction_index;
+  if (!result_dict->GetString("transactionIndex", &transaction_index))
+    return false;
+  if (!HexValueToUint256(transaction_index, &receipt->transaction_index))
+    return false;
+
+  std::string block_number;
+  if (!result_dict->GetString("blockNumber", &block_number))
+    return false;
+  if (!HexValueToUint256(block_number, &receipt->block_number))
+    return false;
+
+  if (!result_dict->GetString("blockHash", &receipt->block_hash))
+    return false;
+
+  std::string cumulative_gas_used;
+  if (!result_dict->GetString("cumulativeGasUsed", &cumulative_gas_used))
+    return false;
+  if (!HexValueToUint256(cumulative_gas_used, &receipt->cumulative_gas_used))
+    return false;
+
+  std::string gas_used;
+  if (!result_dict->GetString("gasUsed", &gas_used))
+    return false;
+  if (!HexValueToUint256(gas_used, &receipt->gas_used))
+    return false;
+
+  // contractAddress can be null
+  result_dict->GetString("contractAddress", &receipt->contract_address);
+
+  // TODO(darkdh): logs
+#if 0
+  const base::ListValue* logs = nullptr;
+  if (!result_dict->GetList("logs", &logs))
+    return false;
+  for (const std::string& entry : logs->GetList())
+    receipt->logs.push_back(entry);
+#endif
+
+  if (!result_dict->GetString("logsBloom", &receipt->logs_bloom))
+    return false;
+
+  std::string status;
+  if (!result_dict->GetString("status", &status))
+    return false;
+  uint32_t status_int = 0;
+  if (!base::HexStringToUInt(status, &status_int))
+    return false;
+  receipt->status = status_int == 1;
+
+  return true;
+}
+
+}  // namespace
+
 bool ParseStringResult(const std::string& json, std::string* value) {
   DCHECK(value);
 
@@ -155,64 +223,38 @@ bool ParseEthGetTransactionReceipt(const std::string& json,
   base::Value result;
   if (!ParseResult(json, &result))
     return false;
-  const base::DictionaryValue* result_dict = nullptr;
-  if (!result.GetAsDictionary(&result_dict))
-    return false;
-  DCHECK(result_dict);
-
-  if (!result_dict->GetString("transactionHash", &receipt->transaction_hash))
-    return false;
-  std::string transaction_index;
-  if (!result_dict->GetString("transactionIndex", &transaction_index))
-    return false;
-  if (!HexValueToUint256(transaction_index, &receipt->transaction_index))
-    return false;
-
-  std::string block_number;
-  if (!result_dict->GetString("blockNumber", &block_number))
-    return false;
-  if (!HexValueToUint256(block_number, &receipt->block_number))
-    return false;
-
-  if (!result_dict->GetString("blockHash", &receipt->block_hash))
-    return false;
-
-  std::string cumulative_gas_used;
-  if (!result_dict->GetString("cumulativeGasUsed", &cumulative_gas_used))
-    return false;
-  if (!HexValueToUint256(cumulative_gas_used, &receipt->cumulative_gas_used))
-    return false;
-
-  std::string gas_used;
-  if (!result_dict->GetString("gasUsed", &gas_used))
-    return false;
-  if (!HexValueToUint256(gas_used, &receipt->gas_used))
-    return false;
-
-  // contractAddress can be null
-  result_dict->GetString("contractAddress", &receipt->contract_address);
-
-  // TODO(darkdh): logs
-#if 0
-  const base::ListValue* logs = nullptr;
-  if (!result_dict->GetList("logs", &logs))
-    return false;
-  for (const std::string& entry : logs->GetList())
-    receipt->logs.push_back(entry);
-#endif
-
-  if (!result_dict->GetString("logsBloom", &receipt->logs_bloom))
-    return false;
-
-  std::string status;
-  if (!result_dict->GetString("status", &status))
-    return false;
-  uint32_t status_int = 0;
-  if (!base::HexStringToUInt(status, &status_int))
-    return false;
-  receipt->status = status_int == 1;
+  return ParseTransactionReceiptResult(result, receipt);
+}
 
-  return true;
+bool ParseEthGetTransactionReceipts(
+    const std::string& json,
+    size_t count,
+    std::vector<absl::optional<TransactionReceipt>>* receipts) {
+  DCHECK(receipts);
+
+  absl::optional<base::Value> responses = base::JSONReader::Read(
+      json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!responses || !responses->is_list())
+    return false;
+
+  receipts->assign(count, absl::nullopt);
+  std::vector<bool> answered(count, false);
+  for (const auto& response : responses->GetList()) {
+    if (!response.is_dict())
+      continue;
+    absl::optional<int> id = response.FindIntKey("id");
+    if (!id || *id < 0 || static_cast<size_t>(*id) >= count)
+      continue;
+    answered[*id] = true;
+    const base::Value* result = response.FindKey("result");
+    TransactionReceipt receipt;
+    // Transactions which are still pending have a null receipt.
+    if (result && ParseTransactionReceiptResult(*result, &receipt))
+      (*receipts)[*id] = std::move(receipt);
+  }
+  // Some nodes cap the size of batches and drop the requests beyond the cap.
+  return std::find(answered.begin(), answered.end(), false) == answered.end();
 }
 
 bool ParseEthSendRawTransaction(const std::string& json, std::string* tx_hash) {
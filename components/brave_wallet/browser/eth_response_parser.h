@@ -12,6 +12,7 @@
 #include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -30,6 +31,13 @@ bool ParseEthGetBalance(const std::string& json, std::string* hex_balance);
 bool ParseEthGetTransactionCount(const std::string& json, uint256_t* count);
 bool ParseEthGetTransactionReceipt(const std::string& json,
                                    TransactionReceipt* receipt);
+// Parses the responses to a batch of |count| eth_getTransactionReceipt
+// requests. |receipts| holds the receipts by request id, receipts which could
+// not be parsed have no value. Fails unless every request has a response.
+bool ParseEthGetTransactionReceipts(
+    const std::string& json,
+    size_t count,
+    std::vector<absl::optional<TransactionReceipt>>* receipts);
 bool ParseEthSendRawTransaction(const std::string& json, std::string* tx_hash);
 bool ParseEthCall(const std::string& json, std::string* result);
 bool ParseEthEstimateGas(const std::string& json, std::string* result);
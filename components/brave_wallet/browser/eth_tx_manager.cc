@@ -586,6 +586,7 @@ void EthTxManager::OnPublishTransaction(std::string tx_meta_id,
   tx_state_manager_->AddOrUpdateTx(*meta);
 
   if (error == mojom::ProviderError::kSuccess) {
+    SpeedUpBlockTracker();
     UpdatePendingTransactions();
   }
 
@@ -878,6 +879,10 @@ std::unique_ptr<EthTxMeta> EthTxManager::GetTxForTesting(
   return GetEthTxStateManager()->GetEthTx(tx_meta_id);
 }
 
+void EthTxManager::OnLatestBlock(uint256_t block_num) {
+  BackOffBlockTracker();
+}
+
 void EthTxManager::OnNewBlock(uint256_t block_num) {
   UpdatePendingTransactions();
 }
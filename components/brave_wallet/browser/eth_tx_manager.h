@@ -148,6 +148,7 @@ class EthTxManager : public TxManager, public EthBlockTracker::Observer {
   FRIEND_TEST_ALL_PREFIXES(EthTxManagerUnitTest, TestSubmittedToConfirmed);
   FRIEND_TEST_ALL_PREFIXES(EthTxManagerUnitTest, RetryTransaction);
   FRIEND_TEST_ALL_PREFIXES(EthTxManagerUnitTest, Reset);
+  FRIEND_TEST_ALL_PREFIXES(EthTxManagerUnitTest, AdaptiveBlockTrackerPolling);
   friend class EthTxManagerUnitTest;
 
   void AddUnapprovedTransaction(mojom::TxDataPtr tx_data,
@@ -251,7 +252,7 @@ class EthTxManager : public TxManager, public EthBlockTracker::Observer {
       const std::string& error_message);
 
   // EthBlockTracker::Observer:
-  void OnLatestBlock(uint256_t block_num) override {}
+  void OnLatestBlock(uint256_t block_num) override;
   void OnNewBlock(uint256_t block_num) override;
 
   EthTxStateManager* GetEthTxStateManager();
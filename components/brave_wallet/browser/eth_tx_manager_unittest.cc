@@ -1640,7 +1640,25 @@ TEST_F(EthTxManagerUnitTest, TestSubmittedToConfirmed) {
               "id":1
             })");
         } else if (header_value == "eth_getTransactionReceipt") {
-          url_loader_factory_.AddResponse(request.url.spec(), R"(
+          // Receipts of both pending transactions are looked up with a single
+          // batch request.
+          url_loader_factory_.AddResponse(request.url.spec(), R"([
+            {
+              "jsonrpc": "2.0",
+              "id":0,
+              "result": {
+                "transactionHash": "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+                "transactionIndex":  "0x1",
+                "blockNumber": "0xb",
+                "blockHash": "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b",
+                "cumulativeGasUsed": "0x33bc",
+                "gasUsed": "0x4dc",
+                "contractAddress": "0xb60e8dd61c5d32be8058bb8eb970870f07233155",
+                "logs": [],
+                "logsBloom": "0x00...0",
+                "status": "0x1"
+              }
+            },
             {
               "jsonrpc": "2.0",
               "id":1,
@@ -1656,7 +1674,7 @@ TEST_F(EthTxManagerUnitTest, TestSubmittedToConfirmed) {
                 "logsBloom": "0x00...0",
                 "status": "0x1"
               }
-            })");
+            }])");
         }
       }));
 
@@ -1693,6 +1711,69 @@ TEST_F(EthTxManagerUnitTest, TestSubmittedToConfirmed) {
   EXPECT_EQ(mojom::TransactionStatus::Submitted, tx_meta1->status());
 }
 
+TEST_F(EthTxManagerUnitTest, AdaptiveBlockTrackerPolling) {
+  base::RunLoop().RunUntilIdle();
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_from(
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress());
+  meta.set_tx_hash(
+      "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238");
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  eth_tx_manager()->tx_state_manager_->AddOrUpdateTx(meta);
+
+  size_t block_number_requests = 0;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        std::string header_value;
+        EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
+        if (header_value == "eth_blockNumber") {
+          block_number_requests++;
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              R"({"jsonrpc":"2.0","id":1,"result":"0x65a8db"})");
+        } else if (header_value == "eth_getTransactionReceipt") {
+          // The transaction is still pending.
+          url_loader_factory_.AddResponse(
+              request.url.spec(), R"([{"jsonrpc":"2.0","id":0,"result":null}])");
+        }
+      }));
+  ASSERT_TRUE(eth_tx_manager()->block_tracker_->IsRunning());
+
+  // Publishing a transaction makes the tracker poll sooner.
+  eth_tx_manager()->SpeedUpBlockTracker();
+  task_environment_.FastForwardBy(
+      base::Seconds(kBlockTrackerSubmittedTxTimeInSeconds));
+  EXPECT_EQ(1UL, block_number_requests);
+
+  // Each poll doubles the interval...
+  task_environment_.FastForwardBy(
+      base::Seconds(2 * kBlockTrackerSubmittedTxTimeInSeconds));
+  EXPECT_EQ(2UL, block_number_requests);
+  task_environment_.FastForwardBy(
+      base::Seconds(4 * kBlockTrackerSubmittedTxTimeInSeconds));
+  EXPECT_EQ(3UL, block_number_requests);
+
+  // ...up to the default one.
+  task_environment_.FastForwardBy(
+      base::Seconds(kBlockTrackerDefaultTimeInSeconds - 1));
+  EXPECT_EQ(3UL, block_number_requests);
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_EQ(4UL, block_number_requests);
+  EXPECT_EQ(base::Seconds(kBlockTrackerDefaultTimeInSeconds),
+            eth_tx_manager()->block_tracker_interval_);
+
+  // Stopping the tracker goes back to the default interval.
+  eth_tx_manager()->SpeedUpBlockTracker();
+  keyring_service_->Lock();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(eth_tx_manager()->block_tracker_->IsRunning());
+  EXPECT_EQ(base::Seconds(kBlockTrackerDefaultTimeInSeconds),
+            eth_tx_manager()->block_tracker_interval_);
+}
+
 TEST_F(EthTxManagerUnitTest, SpeedupTransaction) {
   // Speedup EthSend with gas price + 10% < eth_getGasPrice should use
   // eth_getGasPrice for EthSend.
@@ -91,6 +91,69 @@ TEST(EthereumKeyringUnitTest, Accounts) {
   EXPECT_TRUE(keyring2.GetAddress(0).empty());
 }
 
+TEST(EthereumKeyringUnitTest, CachedAccountAddresses) {
+  EthereumKeyring keyring;
+  std::vector<uint8_t> seed;
+  EXPECT_TRUE(base::HexStringToBytes(
+      "13ca6c28d26812f82db27908de0b0b7b18940cc4e9d96ebd7de190f706741489907ef65b"
+      "8f9e36c31dc46e81472b6a5e40a4487e725ace445b8203f243fb8958",
+      &seed));
+  keyring.ConstructRootHDKey(seed, "m/44'/60'/0'/0");
+  keyring.AddAccounts(10);
+  // Fill the cache.
+  const std::vector<std::string> accounts = keyring.GetAccounts();
+  ASSERT_EQ(accounts.size(), 10u);
+
+  std::vector<uint8_t> message;
+  EXPECT_TRUE(base::HexStringToBytes("deadbeef", &message));
+  for (size_t i = 0; i < accounts.size(); ++i) {
+    // Derive the account from the master key through the full path and
+    // compute its address without the cache of |keyring|.
+    std::unique_ptr<HDKeyBase> key = keyring.master_key_->DeriveChildFromPath(
+        "m/44'/60'/0'/0/" + base::NumberToString(i));
+    ASSERT_TRUE(key);
+    EthereumKeyring uncached_keyring;
+    uncached_keyring.accounts_.push_back(std::move(key));
+    const std::string address = uncached_keyring.GetAddress(0);
+
+    EXPECT_EQ(accounts[i], address);
+    EXPECT_EQ(keyring.GetAddress(i), address);
+    EXPECT_EQ(keyring.GetAccountIndex(address), i);
+    EXPECT_EQ(keyring.GetEncodedPrivateKey(address),
+              uncached_keyring.GetEncodedPrivateKey(address));
+    EXPECT_EQ(keyring.SignMessage(address, message, 0, false),
+              uncached_keyring.SignMessage(address, message, 0, false));
+  }
+
+  // Accounts added after removing one get their own address.
+  keyring.RemoveAccount();
+  keyring.RemoveAccount();
+  EXPECT_TRUE(keyring.GetAddress(9).empty());
+  EXPECT_FALSE(keyring.GetAccountIndex(accounts[9]));
+  keyring.AddAccounts(2);
+  EXPECT_EQ(keyring.GetAccounts(), accounts);
+}
+
+TEST(EthereumKeyringUnitTest, SignMessagesForManyAccounts) {
+  EthereumKeyring keyring;
+  std::vector<uint8_t> seed;
+  EXPECT_TRUE(base::HexStringToBytes(
+      "13ca6c28d26812f82db27908de0b0b7b18940cc4e9d96ebd7de190f706741489907ef65b"
+      "8f9e36c31dc46e81472b6a5e40a4487e725ace445b8203f243fb8958",
+      &seed));
+  keyring.ConstructRootHDKey(seed, "m/44'/60'/0'/0");
+  keyring.AddAccounts(100);
+  const std::vector<std::string> accounts = keyring.GetAccounts();
+  ASSERT_EQ(accounts.size(), 100u);
+
+  std::vector<uint8_t> message;
+  EXPECT_TRUE(base::HexStringToBytes("deadbeef", &message));
+  for (size_t i = 0; i < accounts.size(); ++i) {
+    EXPECT_EQ(keyring.GetAccountIndex(accounts[i]), i);
+    EXPECT_FALSE(keyring.SignMessage(accounts[i], message, 0, false).empty());
+  }
+}
+
 TEST(EthereumKeyringUnitTest, SignTransaction) {
   // Specific signature check is in eth_transaction_unittest.cc
   EthereumKeyring keyring;
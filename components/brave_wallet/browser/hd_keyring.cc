@@ -56,6 +56,8 @@ size_t HDKeyring::GetAccountsNumber() const {
 
 void HDKeyring::RemoveAccount() {
   accounts_.pop_back();
+  if (account_addresses_.size() > accounts_.size())
+    account_addresses_.resize(accounts_.size());
 }
 
 bool HDKeyring::AddImportedAddress(const std::string& address,
@@ -97,7 +99,13 @@ bool HDKeyring::RemoveImportedAccount(const std::string& address) {
 std::string HDKeyring::GetAddress(size_t index) const {
   if (accounts_.empty() || index >= accounts_.size())
     return std::string();
-  return GetAddressInternal(accounts_[index].get());
+  // Accounts are only added and removed at the back.
+  if (account_addresses_.size() != accounts_.size())
+    account_addresses_.resize(accounts_.size());
+  std::string& address = account_addresses_[index];
+  if (address.empty())
+    address = GetAddressInternal(accounts_[index].get());
+  return address;
 }
 
 std::string HDKeyring::GetDiscoveryAddress(size_t index) const {
@@ -69,7 +69,15 @@ class HDKeyring {
  private:
   FRIEND_TEST_ALL_PREFIXES(EthereumKeyringUnitTest, ConstructRootHDKey);
   FRIEND_TEST_ALL_PREFIXES(EthereumKeyringUnitTest, SignMessage);
+  FRIEND_TEST_ALL_PREFIXES(EthereumKeyringUnitTest, CachedAccountAddresses);
   FRIEND_TEST_ALL_PREFIXES(SolanaKeyringUnitTest, ConstructRootHDKey);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
+                           LockDropsCachedAccountAddresses);
+
+  // Addresses of |accounts_|, computed on first use. Looking up an account by
+  // address would otherwise serialize the public key and hash it for every
+  // account, on each signing request.
+  mutable std::vector<std::string> account_addresses_;
 };
 
 }  // namespace brave_wallet
@@ -8,14 +8,17 @@
 #include <memory>
 #include <utility>
 
+#include "base/barrier_callback.h"
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/environment.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
@@ -84,6 +87,24 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
     )");
 }
 
+// ENS returns the zero address for names and resolvers which are not set.
+bool IsZeroAddress(const std::string& address) {
+  return brave_wallet::EthAddress::FromHex(address) ==
+         brave_wallet::EthAddress::FromHex(
+             "0x0000000000000000000000000000000000000000");
+}
+
+// Whether |json| is the error which nodes without support for JSON-RPC batch
+// requests answer them with, e.g. "batch requests are not supported".
+bool IsBatchNotSupportedError(const std::string& json) {
+  brave_wallet::mojom::ProviderError error;
+  std::string error_message;
+  brave_wallet::ParseErrorResult<brave_wallet::mojom::ProviderError>(
+      json, &error, &error_message);
+  return error != brave_wallet::mojom::ProviderError::kParsingError &&
+         base::ToLowerASCII(error_message).find("batch") != std::string::npos;
+}
+
 namespace solana {
 // https://github.com/solana-labs/solana/blob/f7b2951c79cd07685ed62717e78ab1c200924924/rpc/src/rpc.rs#L1717
 constexpr char kAccountNotCreatedError[] = "could not find account";
@@ -104,6 +125,13 @@ JsonRpcService::JsonRpcService(
               unstoppable_domains::MultichainCalls<std::string>>()),
       ud_resolve_dns_calls_(
           std::make_unique<unstoppable_domains::MultichainCalls<GURL>>()),
+      ens_get_eth_addr_cache_(
+          std::make_unique<DomainResolutionCache<std::string>>()),
+      ens_get_content_hash_cache_(
+          std::make_unique<DomainResolutionCache<std::string>>()),
+      ud_get_eth_addr_cache_(
+          std::make_unique<DomainResolutionCache<std::string>>()),
+      ud_resolve_dns_cache_(std::make_unique<DomainResolutionCache<GURL>>()),
       prefs_(prefs),
       weak_ptr_factory_(this) {
   if (!SetNetwork(GetCurrentChainId(prefs_, mojom::CoinType::ETH),
@@ -123,6 +151,13 @@ void JsonRpcService::SetAPIRequestHelperForTesting(
       GetNetworkTrafficAnnotationTag(), url_loader_factory));
 }
 
+void JsonRpcService::ClearDomainResolutionCachesForTesting() {
+  ens_get_eth_addr_cache_->Clear();
+  ens_get_content_hash_cache_->Clear();
+  ud_get_eth_addr_cache_->Clear();
+  ud_resolve_dns_cache_->Clear();
+}
+
 JsonRpcService::~JsonRpcService() {}
 
 // static
@@ -189,7 +224,34 @@ void JsonRpcService::RequestInternal(
       request_headers["X-Eth-Block"] = "true";
     }
   }
+  SendRequestInternal(json_payload, std::move(request_headers),
+                      auto_retry_on_network_change, network_url,
+                      std::move(callback), std::move(conversion_callback));
+}
+
+void JsonRpcService::RequestBatchInternal(
+    const std::string& json_payload,
+    const std::string& method,
+    bool auto_retry_on_network_change,
+    const GURL& network_url,
+    RequestIntermediateCallback callback) {
+  DCHECK(network_url.is_valid());
 
+  base::flat_map<std::string, std::string> request_headers;
+  request_headers["X-Eth-Method"] = method;
+  SendRequestInternal(json_payload, std::move(request_headers),
+                      auto_retry_on_network_change, network_url,
+                      std::move(callback), base::NullCallback());
+}
+
+void JsonRpcService::SendRequestInternal(
+    const std::string& json_payload,
+    base::flat_map<std::string, std::string> request_headers,
+    bool auto_retry_on_network_change,
+    const GURL& network_url,
+    RequestIntermediateCallback callback,
+    api_request_helper::APIRequestHelper::ResponseConversionCallback
+        conversion_callback) {
   std::unique_ptr<base::Environment> env(base::Environment::Create());
   std::string brave_key(BUILDFLAG(BRAVE_SERVICES_KEY));
   if (env->HasVar("BRAVE_SERVICES_KEY")) {
@@ -390,8 +452,11 @@ bool JsonRpcService::SetNetwork(const std::string& chain_id,
   dict->SetStringKey(GetPrefKeyForCoinType(coin), chain_id);
 
   FireNetworkChanged(coin);
-  if (coin == mojom::CoinType::ETH)
+  if (coin == mojom::CoinType::ETH) {
     MaybeUpdateIsEip1559(chain_id);
+    // Addresses are resolved on the selected network.
+    ens_get_eth_addr_cache_->Clear();
+  }
   return true;
 }
 
@@ -870,6 +935,98 @@ void JsonRpcService::OnGetTransactionReceipt(
   std::move(callback).Run(receipt, mojom::ProviderError::kSuccess, "");
 }
 
+void JsonRpcService::GetTransactionReceipts(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback) {
+  const GURL& network_url = network_urls_[mojom::CoinType::ETH];
+  if (networks_without_batch_receipts_.contains(network_url)) {
+    GetTransactionReceiptsOneByOne(tx_hashes, std::move(callback));
+    return;
+  }
+
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnGetTransactionReceipts, weak_ptr_factory_.GetWeakPtr(),
+      tx_hashes, network_url, std::move(callback));
+  RequestBatchInternal(eth::eth_getTransactionReceipts(tx_hashes),
+                       "eth_getTransactionReceipt", true, network_url,
+                       std::move(internal_callback));
+}
+
+void JsonRpcService::OnGetTransactionReceipts(
+    const std::vector<std::string>& tx_hashes,
+    const GURL& network_url,
+    GetTxReceiptsCallback callback,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  std::vector<absl::optional<TransactionReceipt>> receipts;
+  // A 4xx status means the batch was rejected, other failures are reported
+  // and retried with the next lookup.
+  const bool rejected = status >= 400 && status < 500;
+  if (!rejected && (status < 200 || status > 299)) {
+    std::move(callback).Run(
+        std::move(receipts), mojom::ProviderError::kInternalError,
+        l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR));
+    return;
+  }
+  if (!rejected && eth::ParseEthGetTransactionReceipts(body, tx_hashes.size(),
+                                                       &receipts)) {
+    std::move(callback).Run(std::move(receipts),
+                            mojom::ProviderError::kSuccess, "");
+    return;
+  }
+
+  // Only a node which says it does not support batches is sent single
+  // lookups from now on. Other failures, like a batch cut short by a size
+  // cap, fall back for this lookup and the next one tries a batch again.
+  if (IsBatchNotSupportedError(body)) {
+    VLOG(1) << "Looking up receipts without batch requests on "
+            << network_url.GetWithEmptyPath();
+    networks_without_batch_receipts_.insert(network_url);
+  }
+  GetTransactionReceiptsOneByOne(tx_hashes, std::move(callback));
+}
+
+void JsonRpcService::GetTransactionReceiptsOneByOne(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback) {
+  if (tx_hashes.empty()) {
+    std::move(callback).Run({}, mojom::ProviderError::kSuccess, "");
+    return;
+  }
+
+  auto barrier_callback = base::BarrierCallback<IndexedTxReceipt>(
+      tx_hashes.size(),
+      base::BindOnce(&JsonRpcService::OnGetTransactionReceiptsOneByOne,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+  for (size_t i = 0; i < tx_hashes.size(); ++i) {
+    GetTransactionReceipt(
+        tx_hashes[i],
+        base::BindOnce(
+            [](base::RepeatingCallback<void(IndexedTxReceipt)> barrier_callback,
+               size_t index, TransactionReceipt receipt,
+               mojom::ProviderError error, const std::string& error_message) {
+              // Transactions which are still pending have no receipt.
+              barrier_callback.Run(
+                  {index, error == mojom::ProviderError::kSuccess
+                              ? absl::make_optional(std::move(receipt))
+                              : absl::nullopt});
+            },
+            barrier_callback, i));
+  }
+}
+
+void JsonRpcService::OnGetTransactionReceiptsOneByOne(
+    GetTxReceiptsCallback callback,
+    std::vector<IndexedTxReceipt> indexed_receipts) {
+  std::vector<absl::optional<TransactionReceipt>> receipts(
+      indexed_receipts.size());
+  for (auto& indexed_receipt : indexed_receipts)
+    receipts[indexed_receipt.first] = std::move(indexed_receipt.second);
+  std::move(callback).Run(std::move(receipts), mojom::ProviderError::kSuccess,
+                          "");
+}
+
 void JsonRpcService::SendRawTransaction(const std::string& signed_tx,
                                         SendRawTxCallback callback) {
   auto internal_callback =
@@ -1048,14 +1205,23 @@ void JsonRpcService::OnEnsRegistryGetResolver(
     return;
   }
 
+  // The name is not registered, which is a result worth caching rather than
+  // an error.
+  if (IsZeroAddress(resolver_address))
+    resolver_address.clear();
+
   std::move(callback).Run(resolver_address, mojom::ProviderError::kSuccess, "");
 }
 
 void JsonRpcService::EnsResolverGetContentHash(const std::string& domain,
                                                StringResultCallback callback) {
-  auto internal_callback = base::BindOnce(
-      &JsonRpcService::ContinueEnsResolverGetContentHash,
-      weak_ptr_factory_.GetWeakPtr(), domain, std::move(callback));
+  if (!ens_get_content_hash_cache_->AddCallback(domain, std::move(callback)))
+    return;
+
+  auto internal_callback =
+      base::BindOnce(&JsonRpcService::ContinueEnsResolverGetContentHash,
+                     weak_ptr_factory_.GetWeakPtr(), domain,
+                     ens_get_content_hash_cache_->GetResolveCallback(domain));
   EnsRegistryGetResolver(domain, std::move(internal_callback));
 }
 
@@ -1108,9 +1274,9 @@ void JsonRpcService::OnEnsResolverGetContentHash(
     return;
   }
 
+  // An empty content hash means the name has none set.
   std::string content_hash;
-  if (!eth::ParseEnsResolverContentHash(body, &content_hash) ||
-      content_hash.empty()) {
+  if (!eth::ParseEnsResolverContentHash(body, &content_hash)) {
     mojom::ProviderError error;
     std::string error_message;
     ParseErrorResult<mojom::ProviderError>(body, &error, &error_message);
@@ -1130,9 +1296,12 @@ void JsonRpcService::EnsGetEthAddr(const std::string& domain,
     return;
   }
 
+  if (!ens_get_eth_addr_cache_->AddCallback(domain, std::move(callback)))
+    return;
+
   auto internal_callback = base::BindOnce(
       &JsonRpcService::ContinueEnsGetEthAddr, weak_ptr_factory_.GetWeakPtr(),
-      domain, std::move(callback));
+      domain, ens_get_eth_addr_cache_->GetResolveCallback(domain));
   EnsRegistryGetResolver(domain, std::move(internal_callback));
 }
 
@@ -1184,17 +1353,15 @@ void JsonRpcService::OnEnsGetEthAddr(
     return;
   }
 
+  if (IsZeroAddress(address))
+    address.clear();
+
   std::move(callback).Run(address, mojom::ProviderError::kSuccess, "");
 }
 
 void JsonRpcService::UnstoppableDomainsResolveDns(
     const std::string& domain,
     UnstoppableDomainsResolveDnsCallback callback) {
-  if (ud_resolve_dns_calls_->HasCall(domain)) {
-    ud_resolve_dns_calls_->AddCallback(domain, std::move(callback));
-    return;
-  }
-
   if (!IsValidUnstoppableDomain(domain)) {
     std::move(callback).Run(
         GURL(), mojom::ProviderError::kInvalidParams,
@@ -1211,7 +1378,11 @@ void JsonRpcService::UnstoppableDomainsResolveDns(
     return;
   }
 
-  ud_resolve_dns_calls_->AddCallback(domain, std::move(callback));
+  if (!ud_resolve_dns_cache_->AddCallback(domain, std::move(callback)))
+    return;
+
+  ud_resolve_dns_calls_->AddCallback(
+      domain, ud_resolve_dns_cache_->GetResolveCallback(domain));
   for (const auto& chain_id : ud_resolve_dns_calls_->GetChains()) {
     auto internal_callback =
         base::BindOnce(&JsonRpcService::OnUnstoppableDomainsResolveDns,
@@ -1259,11 +1430,6 @@ void JsonRpcService::OnUnstoppableDomainsResolveDns(
 void JsonRpcService::UnstoppableDomainsGetEthAddr(
     const std::string& domain,
     UnstoppableDomainsGetEthAddrCallback callback) {
-  if (ud_get_eth_addr_calls_->HasCall(domain)) {
-    ud_get_eth_addr_calls_->AddCallback(domain, std::move(callback));
-    return;
-  }
-
   if (!IsValidUnstoppableDomain(domain)) {
     std::move(callback).Run(
         "", mojom::ProviderError::kInvalidParams,
@@ -1279,7 +1445,11 @@ void JsonRpcService::UnstoppableDomainsGetEthAddr(
     return;
   }
 
-  ud_get_eth_addr_calls_->AddCallback(domain, std::move(callback));
+  if (!ud_get_eth_addr_cache_->AddCallback(domain, std::move(callback)))
+    return;
+
+  ud_get_eth_addr_calls_->AddCallback(
+      domain, ud_get_eth_addr_cache_->GetResolveCallback(domain));
   for (const auto& chain_id : ud_get_eth_addr_calls_->GetChains()) {
     auto internal_callback =
         base::BindOnce(&JsonRpcService::OnUnstoppableDomainsGetEthAddr,
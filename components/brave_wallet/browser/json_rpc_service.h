@@ -14,6 +14,7 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
@@ -44,6 +45,9 @@ template <class ResultType>
 class MultichainCalls;
 }  // namespace unstoppable_domains
 
+template <class ResultType>
+class DomainResolutionCache;
+
 class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
  public:
   JsonRpcService(
@@ -135,6 +139,18 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   void GetTransactionReceipt(const std::string& tx_hash,
                              GetTxReceiptCallback callback);
 
+  // Looks up the receipts of |tx_hashes| with a single JSON-RPC batch request.
+  // |receipts| is in the order of |tx_hashes|, transactions which are still
+  // pending or could not be looked up have no receipt. When the batch fails,
+  // one eth_getTransactionReceipt request per hash is sent instead. Networks
+  // which answer that they do not support batches are not sent batches again.
+  using GetTxReceiptsCallback = base::OnceCallback<void(
+      std::vector<absl::optional<TransactionReceipt>> receipts,
+      mojom::ProviderError error,
+      const std::string& error_message)>;
+  void GetTransactionReceipts(const std::vector<std::string>& tx_hashes,
+                              GetTxReceiptsCallback callback);
+
   using SendRawTxCallback =
       base::OnceCallback<void(const std::string& tx_hash,
                               mojom::ProviderError error,
@@ -314,6 +330,7 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
 
   void SetAPIRequestHelperForTesting(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+  void ClearDomainResolutionCachesForTesting();
 
   // Solana JSON RPCs
   void GetSolanaBalance(const std::string& pubkey,
@@ -418,6 +435,20 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
+  void OnGetTransactionReceipts(
+      const std::vector<std::string>& tx_hashes,
+      const GURL& network_url,
+      GetTxReceiptsCallback callback,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  using IndexedTxReceipt =
+      std::pair<size_t, absl::optional<TransactionReceipt>>;
+  void GetTransactionReceiptsOneByOne(const std::vector<std::string>& tx_hashes,
+                                      GetTxReceiptsCallback callback);
+  void OnGetTransactionReceiptsOneByOne(
+      GetTxReceiptsCallback callback,
+      std::vector<IndexedTxReceipt> indexed_receipts);
   void OnSendRawTransaction(
       SendRawTxCallback callback,
       const int status,
@@ -514,6 +545,20 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       RequestIntermediateCallback callback,
       api_request_helper::APIRequestHelper::ResponseConversionCallback
           conversion_callback);
+  // Sends a JSON-RPC batch whose requests all call |method|.
+  void RequestBatchInternal(const std::string& json_payload,
+                            const std::string& method,
+                            bool auto_retry_on_network_change,
+                            const GURL& network_url,
+                            RequestIntermediateCallback callback);
+  void SendRequestInternal(
+      const std::string& json_payload,
+      base::flat_map<std::string, std::string> request_headers,
+      bool auto_retry_on_network_change,
+      const GURL& network_url,
+      RequestIntermediateCallback callback,
+      api_request_helper::APIRequestHelper::ResponseConversionCallback
+          conversion_callback);
   void OnEthChainIdValidatedForOrigin(
       mojom::NetworkInfoPtr chain,
       const url::Origin& origin,
@@ -633,6 +678,13 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       ud_get_eth_addr_calls_;
   std::unique_ptr<unstoppable_domains::MultichainCalls<GURL>>
       ud_resolve_dns_calls_;
+  std::unique_ptr<DomainResolutionCache<std::string>> ens_get_eth_addr_cache_;
+  std::unique_ptr<DomainResolutionCache<std::string>>
+      ens_get_content_hash_cache_;
+  std::unique_ptr<DomainResolutionCache<std::string>> ud_get_eth_addr_cache_;
+  std::unique_ptr<DomainResolutionCache<GURL>> ud_resolve_dns_cache_;
+  // Networks whose receipts are looked up without batch requests.
+  base::flat_set<GURL> networks_without_batch_receipts_;
 
   mojo::RemoteSet<mojom::JsonRpcServiceObserver> observers_;
 
@@ -412,6 +412,7 @@ class JsonRpcServiceUnitTest : public testing::Test {
     ASSERT_TRUE(network_url.is_valid());
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&, network_url](const network::ResourceRequest& request) {
+          ud_ens_requests_count_++;
           base::StringPiece request_string(request.request_body->elements()
                                                ->at(0)
                                                .As<network::DataElementBytes>()
@@ -458,6 +459,55 @@ class JsonRpcServiceUnitTest : public testing::Test {
         }));
   }
 
+  // Answers ENS lookups of a name which is not registered, or with
+  // |has_resolver| of a name with a resolver but without an address and a
+  // content hash.
+  void SetENSNotSetInterceptor(const std::string& chain_id, bool has_resolver) {
+    GURL network_url = AddInfuraProjectId(
+        GetNetworkURL(prefs(), chain_id, mojom::CoinType::ETH));
+    ASSERT_TRUE(network_url.is_valid());
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, network_url,
+         has_resolver](const network::ResourceRequest& request) {
+          ud_ens_requests_count_++;
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          url_loader_factory_.ClearResponses();
+          if (request_string.find(GetFunctionHash("resolver(bytes32)")) !=
+              std::string::npos) {
+            url_loader_factory_.AddResponse(
+                network_url.spec(),
+                has_resolver
+                    ? "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+                      "\"0x0000000000000000000000004976fb03c32e5b8cfe2b6ccb31c0"
+                      "9ba78ebaba41\"}"
+                    : "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+                      "\"0x000000000000000000000000000000000000000000000000000"
+                      "0000000000000\"}");
+          } else if (request_string.find(GetFunctionHash(
+                         "contenthash(bytes32)")) != std::string::npos) {
+            url_loader_factory_.AddResponse(
+                network_url.spec(),
+                "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+                "\"0x0000000000000000000000000000000000000000000000000000000000"
+                "00002000000000000000000000000000000000000000000000000000000000"
+                "00000000\"}");
+          } else if (request_string.find(GetFunctionHash("addr(bytes32)")) !=
+                     std::string::npos) {
+            url_loader_factory_.AddResponse(
+                network_url.spec(),
+                "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+                "\"0x0000000000000000000000000000000000000000000000000000000000"
+                "000000\"}");
+          } else {
+            url_loader_factory_.AddResponse(request.url.spec(), "",
+                                            net::HTTP_REQUEST_TIMEOUT);
+          }
+        }));
+  }
+
   void SetTokenMetadataInterceptor(
       const std::string& interface_id,
       const std::string& chain_id,
@@ -950,6 +1000,8 @@ class JsonRpcServiceUnitTest : public testing::Test {
  protected:
   std::unique_ptr<JsonRpcService> json_rpc_service_;
   network::TestURLLoaderFactory url_loader_factory_;
+  // Requests answered by the interceptor of SetUDENSInterceptor().
+  size_t ud_ens_requests_count_ = 0;
 
  private:
   base::test::ScopedFeatureList feature_list_;
@@ -1143,6 +1195,7 @@ TEST_F(JsonRpcServiceUnitTest, EnsResolverGetContentHash) {
   base::RunLoop().RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
+  json_rpc_service_->ClearDomainResolutionCachesForTesting();
   callback_called = false;
   SetHTTPRequestTimeoutInterceptor();
   json_rpc_service_->EnsResolverGetContentHash(
@@ -1184,6 +1237,81 @@ TEST_F(JsonRpcServiceUnitTest, EnsGetEthAddr) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(JsonRpcServiceUnitTest, EnsLookupsAreCached) {
+  SetUDENSInterceptor(mojom::kMainnetChainId);
+  EXPECT_TRUE(SetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH));
+  ud_ens_requests_count_ = 0;
+
+  // Concurrent navigations to the same domain share one round of requests,
+  // the resolver and the content hash lookups.
+  base::MockCallback<JsonRpcService::StringResultCallback> callback;
+  EXPECT_CALL(callback, Run(testing::Not(""), mojom::ProviderError::kSuccess,
+                            ""))
+      .Times(3);
+  for (int i = 0; i < 3; ++i)
+    json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(2u, ud_ens_requests_count_);
+
+  // Later navigations are resolved without any request.
+  EXPECT_CALL(callback, Run(testing::Not(""), mojom::ProviderError::kSuccess,
+                            ""));
+  json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(2u, ud_ens_requests_count_);
+
+  EXPECT_CALL(callback, Run("0x983110309620D911731Ac0932219af06091b6744",
+                            mojom::ProviderError::kSuccess, ""))
+      .Times(2);
+  json_rpc_service_->EnsGetEthAddr("brantly.eth", callback.Get());
+  json_rpc_service_->EnsGetEthAddr("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(4u, ud_ens_requests_count_);
+
+  // Addresses are resolved again once the selected network changes.
+  EXPECT_TRUE(SetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH));
+  EXPECT_CALL(callback, Run("0x983110309620D911731Ac0932219af06091b6744",
+                            mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->EnsGetEthAddr("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(6u, ud_ens_requests_count_);
+}
+
+TEST_F(JsonRpcServiceUnitTest, EnsNamesNotSetAreCached) {
+  EXPECT_TRUE(SetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH));
+  base::MockCallback<JsonRpcService::StringResultCallback> callback;
+
+  // A name which is not registered has the zero address as resolver.
+  SetENSNotSetInterceptor(mojom::kMainnetChainId, false);
+  ud_ens_requests_count_ = 0;
+  EXPECT_CALL(callback, Run("", mojom::ProviderError::kSuccess, "")).Times(4);
+  for (int i = 0; i < 2; ++i) {
+    json_rpc_service_->EnsResolverGetContentHash("missing.eth",
+                                                 callback.Get());
+    json_rpc_service_->EnsGetEthAddr("missing.eth", callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  // One resolver lookup for each cache, none when looking up again.
+  EXPECT_EQ(2u, ud_ens_requests_count_);
+
+  // A registered name without an address and a content hash.
+  SetENSNotSetInterceptor(mojom::kMainnetChainId, true);
+  ud_ens_requests_count_ = 0;
+  EXPECT_CALL(callback, Run("", mojom::ProviderError::kSuccess, "")).Times(4);
+  for (int i = 0; i < 2; ++i) {
+    json_rpc_service_->EnsResolverGetContentHash("unset.eth", callback.Get());
+    json_rpc_service_->EnsGetEthAddr("unset.eth", callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(4u, ud_ens_requests_count_);
+}
+
 TEST_F(JsonRpcServiceUnitTest, AddEthereumChainApproved) {
   mojom::NetworkInfo chain("0x111", "chain_name", {"https://url1.com"},
                            {"https://url1.com"}, {"https://url1.com"}, "symbol",
@@ -1976,6 +2104,7 @@ TEST_F(UnstoppableDomainsUnitTest, GetEthAddr_PolygonResult) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDomainResolutionCachesForTesting();
   EXPECT_CALL(callback, Run(k0x3a2f3fAddr, mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsGetEthAddr("javajobs.crypto",
                                                   callback.Get());
@@ -1984,6 +2113,7 @@ TEST_F(UnstoppableDomainsUnitTest, GetEthAddr_PolygonResult) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDomainResolutionCachesForTesting();
   EXPECT_CALL(callback, Run(k0x3a2f3fAddr, mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsGetEthAddr("javajobs.crypto",
                                                   callback.Get());
@@ -2057,6 +2187,39 @@ TEST_F(UnstoppableDomainsUnitTest, GetEthAddr_ManyCalls) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(UnstoppableDomainsUnitTest, GetEthAddr_Cached) {
+  base::MockCallback<GetEthAddrCallback> callback;
+  EXPECT_CALL(callback, Run(k0x3a2f3fAddr, mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->UnstoppableDomainsGetEthAddr("javajobs.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(2, url_loader_factory_.NumPending());
+  SetEthResponse(MakeJsonRpcStringResponse(k0x8aaD44Addr));
+  SetPolygonResponse(MakeJsonRpcStringResponse(k0x3a2f3fAddr));
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  EXPECT_CALL(callback, Run(k0x3a2f3fAddr, mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->UnstoppableDomainsGetEthAddr("javajobs.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  // Domains without an address are cached too.
+  EXPECT_CALL(callback, Run("", mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->UnstoppableDomainsGetEthAddr("brad.crypto",
+                                                  callback.Get());
+  SetEthResponse(MakeJsonRpcStringResponse(""));
+  SetPolygonResponse(MakeJsonRpcStringResponse(""));
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  EXPECT_CALL(callback, Run("", mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->UnstoppableDomainsGetEthAddr("brad.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  testing::Mock::VerifyAndClearExpectations(&callback);
+}
+
 TEST_F(UnstoppableDomainsUnitTest, ResolveDns_PolygonNetworkError) {
   base::MockCallback<ResolveDnsCallback> callback;
   EXPECT_CALL(callback,
@@ -2110,6 +2273,7 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_PolygonResult) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDomainResolutionCachesForTesting();
   EXPECT_CALL(callback, Run(GURL("https://brave.com"),
                             mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
@@ -2119,6 +2283,7 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_PolygonResult) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDomainResolutionCachesForTesting();
   EXPECT_CALL(callback, Run(GURL("https://brave.com"),
                             mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
@@ -2139,6 +2304,7 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_FallbackToEthMainnet) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDomainResolutionCachesForTesting();
   EXPECT_CALL(callback, Run(GURL("https://brave.com"),
                             mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
@@ -2214,6 +2380,30 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_ManyCalls) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(UnstoppableDomainsUnitTest, ResolveDns_Cached) {
+  base::MockCallback<ResolveDnsCallback> callback;
+  EXPECT_CALL(callback, Run(GURL("https://brave.com"),
+                            mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(2, url_loader_factory_.NumPending());
+  SetEthResponse(DnsIpfsResponse());
+  SetPolygonResponse(DnsBraveResponse());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  // Navigating again resolves the domain without any request.
+  EXPECT_CALL(callback, Run(GURL("https://brave.com"),
+                            mojom::ProviderError::kSuccess, ""))
+      .Times(10);
+  for (int i = 0; i < 10; ++i) {
+    json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                    callback.Get());
+  }
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  testing::Mock::VerifyAndClearExpectations(&callback);
+}
+
 TEST_F(JsonRpcServiceUnitTest, GetIsEip1559) {
   bool callback_called = false;
   GURL expected_network =
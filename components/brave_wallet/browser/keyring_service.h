@@ -256,6 +256,8 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
                            GetMnemonicForDefaultKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockAndUnlock);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
+                           LockDropsCachedAccountAddresses);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, Reset);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, AccountMetasForKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, CreateAndRestoreWallet);
@@ -9,23 +9,17 @@
 
 namespace {
 
-// Decodes an integer
-bool RLPToInteger(const std::string& s, size_t* val) {
-  size_t length = s.length();
-  if (length == 0) {
+// Decodes a big endian integer
+bool RLPToInteger(base::span<const uint8_t> input, size_t* val) {
+  if (input.empty()) {
     return false;
   }
 
-  if (length == 1) {
-    *val = static_cast<size_t>(static_cast<uint8_t>(s[0]));
-    return true;
-  }
-
-  size_t v2;
-  if (length <= 1 || !RLPToInteger(s.substr(0, length - 1), &v2)) {
-    return false;
+  size_t result = 0;
+  for (uint8_t byte : input) {
+    result = result * 256 + byte;
   }
-  *val = static_cast<size_t>(static_cast<uint8_t>(s[length - 1]) + v2 * 256);
+  *val = result;
   return true;
 }
 
@@ -34,69 +28,54 @@ bool IsWithinBounds(size_t offset, size_t data_len, size_t length) {
   return offset <= length && data_len <= length && offset + data_len <= length;
 }
 
-// Decodes an offset, length, and value
-bool RLPDecodeLength(const std::string& s,
+// Decodes the offset and length of the payload of the item at the start of
+// |input|, and whether the item is a list
+bool RLPDecodeLength(base::span<const uint8_t> input,
                      size_t* offset,
                      size_t* data_len,
-                     base::Value* value) {
-  size_t length = s.length();
+                     bool* is_list) {
+  size_t length = input.size();
   if (length == 0) {
     return false;
   }
-  uint8_t prefix = static_cast<uint8_t>(s[0]);
+  uint8_t prefix = input[0];
+  *is_list = false;
   if (prefix <= 0x7f) {
     *offset = 0;
     *data_len = 1;
-    std::string str = {s[0]};
-    *value = base::Value(str);
     return true;
   }
 
-  if (prefix <= 0xb7 && length > prefix - 0x80) {
-    size_t strLen = prefix - 0x80;
+  if (prefix <= 0xb7 && length > static_cast<size_t>(prefix - 0x80)) {
     *offset = 1;
-    *data_len = strLen;
-    if (!IsWithinBounds(*offset, *data_len, length)) {
-      return false;
-    }
+    *data_len = prefix - 0x80;
     // If a string length is 1 it should have been handled by the single byte
     // clause above.
-    if (*data_len == 1) {
-      return false;
-    }
-    std::string str = s.substr(*offset, *data_len);
-    *value = base::Value(str);
-    return true;
+    return *data_len != 1;
   }
 
-  size_t i;
-  if (1 + prefix - 0xb7 <= length &&
-      RLPToInteger(s.substr(1, prefix - 0xb7), &i)) {
-    if (prefix <= 0xbf && length > prefix - 0xb7 &&
-        length > prefix - 0xb7 + i) {
-      size_t strLen = i;
-      *offset = 1 + prefix - 0xb7;
-      *data_len = strLen;
+  if (prefix >= 0xb8 && prefix <= 0xbf) {
+    size_t len_length = prefix - 0xb7;
+    size_t i;
+    if (len_length < length && RLPToInteger(input.subspan(1, len_length), &i) &&
+        length > len_length + i) {
+      *offset = 1 + len_length;
+      *data_len = i;
       if (!IsWithinBounds(*offset, *data_len, length)) {
         return false;
       }
       // If a list contains 0-55 bytes, it should have been handled above by
       // the RLP encoding spec.  So this input should never happen, even though
       // it could in theory decode properly.
-      if (*data_len <= 55) {
-        return false;
-      }
-
-      std::string str = s.substr(*offset, *data_len);
-      *value = base::Value(str);
-      return true;
+      return *data_len > 55;
     }
   }
 
-  if (prefix <= 0xf7 && length > prefix - 0xc0) {
+  *is_list = true;
+  if (prefix >= 0xc0 && prefix <= 0xf7 &&
+      length > static_cast<size_t>(prefix - 0xc0)) {
     *offset = 1;
     *data_len = prefix - 0xc0;
-    *value = base::ListValue();
     return true;
   }
 
@@ -104,68 +83,56 @@ bool RLPDecodeLength(const std::string& s,
   // total payload of the list whose length is equal to the first byte minus
   // 0xf7 follows the first byte, and the concatenation of the RLP encodings
   // of all items of the list follows the total payload of the list;
-  size_t list_data_len;
-  size_t list_len_length = prefix - 0xf7;
-  if (prefix <= 0xff && length >= 1 + prefix - 0xf7 &&
-      RLPToInteger(s.substr(1, list_len_length), &list_data_len)) {
-    // Skip past the prefix and the list len length
-    *offset = 1 + list_len_length;
-    *data_len = list_data_len;
-    // If a list contains 0-55 elements, it should have been handled above by
-    // the RLP encoding spec.  So this input should never happen, even though
-    // it could in theory decode properly.
-    if (*data_len <= 55 || !IsWithinBounds(*offset, *data_len, length)) {
-      return false;
+  if (prefix >= 0xf8) {
+    size_t list_len_length = prefix - 0xf7;
+    size_t list_data_len;
+    if (length >= 1 + list_len_length &&
+        RLPToInteger(input.subspan(1, list_len_length), &list_data_len)) {
+      // Skip past the prefix and the list len length
+      *offset = 1 + list_len_length;
+      *data_len = list_data_len;
+      // If a list contains 0-55 elements, it should have been handled above by
+      // the RLP encoding spec.  So this input should never happen, even though
+      // it could in theory decode properly.
+      return *data_len > 55 && IsWithinBounds(*offset, *data_len, length);
     }
-    *value = base::ListValue();
-    return true;
   }
 
   return false;
 }
 
-// Decodes a string and gives the result, an offset, and a data_len
-bool RLPDecodeInternal(const std::string& s,
+// Decodes the item at the start of |input| and gives the result and the
+// number of bytes it spans. Nested items are decoded from views of |input|,
+// only string payloads are copied into |output|.
+bool RLPDecodeInternal(base::span<const uint8_t> input,
                        base::Value* output,
-                       size_t* offset,
-                       size_t* data_len) {
-  size_t length = s.length();
-  if (!RLPDecodeLength(s, offset, data_len, output)) {
+                       size_t* item_len) {
+  size_t offset;
+  size_t data_len;
+  bool is_list;
+  if (!RLPDecodeLength(input, &offset, &data_len, &is_list) ||
+      !IsWithinBounds(offset, data_len, input.size())) {
     return false;
   }
+  *item_len = offset + data_len;
+  auto payload = input.subspan(offset, data_len);
 
-  if (output->is_string()) {
-    if (!IsWithinBounds(*offset, *data_len, length)) {
-      return false;
-    }
-    std::string str = s.substr(*offset, *data_len);
-    *output = base::Value(str);
-  } else if (output->is_list()) {
-    *output = base::ListValue();
-    base::ListValue* output_list;
-    if (!output->GetAsList(&output_list)) {
-      return false;
-    }
-    if (!IsWithinBounds(*offset, *data_len, length)) {
+  if (!is_list) {
+    *output = base::Value(std::string(payload.begin(), payload.end()));
+    return true;
+  }
+
+  base::Value list(base::Value::Type::LIST);
+  while (!payload.empty()) {
+    base::Value v;
+    size_t len;
+    if (!RLPDecodeInternal(payload, &v, &len)) {
       return false;
     }
-    std::string sub = s.substr(*offset, *data_len);
-    while (sub.length() > 0) {
-      base::Value v;
-      size_t offset2, data_len2;
-      if (!RLPDecodeInternal(sub, &v, &offset2, &data_len2)) {
-        return false;
-      }
-      output_list->Append(std::move(v));
-      *offset += data_len2 + offset2;
-      *data_len -= data_len2 + offset2;
-      if (!IsWithinBounds(*offset, *data_len, length)) {
-        return false;
-      }
-      sub = s.substr(*offset, *data_len);
-    }
+    list.Append(std::move(v));
+    payload = payload.subspan(len);
   }
-
+  *output = std::move(list);
   return true;
 }
 
@@ -173,17 +140,20 @@ bool RLPDecodeInternal(const std::string& s,
 
 namespace brave_wallet {
 
-bool RLPDecode(const std::string& s, base::Value* output) {
+bool RLPDecode(base::span<const uint8_t> input, base::Value* output) {
   if (!output) {
     return false;
   }
-  size_t offset;
-  size_t data_len;
-  bool result = RLPDecodeInternal(s, output, &offset, &data_len);
+  size_t item_len;
+  bool result = RLPDecodeInternal(input, output, &item_len);
   if (!result) {
     *output = base::Value();
   }
   return result;
 }
 
+bool RLPDecode(const std::string& s, base::Value* output) {
+  return RLPDecode(base::as_bytes(base::make_span(s)), output);
+}
+
 }  // namespace brave_wallet
@@ -8,12 +8,14 @@
 
 #include <string>
 
+#include "base/containers/span.h"
 #include "base/values.h"
 
 namespace brave_wallet {
 
 // Recursive Length Prefix (RLP) decoding of arbitrarily nested arrays of data
-// Input string should be a hex string but without the 0x prefix
+bool RLPDecode(base::span<const uint8_t> input, base::Value* output);
+// Same as above, |s| holds the raw bytes to decode
 bool RLPDecode(const std::string& s, base::Value* output);
 
 }  // namespace brave_wallet
@@ -4,9 +4,11 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <string>
+#include <utility>
 
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_wallet/browser/rlp_decode.h"
+#include "brave/components/brave_wallet/browser/rlp_encode.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace {
@@ -393,4 +395,54 @@ TEST(RLPDecodeTest, InvalidInputLessThanLongLengthList2) {
   ASSERT_TRUE(val.is_none());
 }
 
+TEST(RLPDecodeTest, NestedAccessList) {
+  // A list of lists of strings, similar to a transaction carrying a large
+  // access list.
+  base::Value list(base::Value::Type::LIST);
+  for (int i = 0; i < 200; i++) {
+    base::Value item(base::Value::Type::LIST);
+    item.Append(base::Value(std::string(20, 'a')));
+    base::Value keys(base::Value::Type::LIST);
+    for (int j = 0; j < 20; j++) {
+      keys.Append(base::Value(std::string(32, 'b')));
+    }
+    item.Append(std::move(keys));
+    list.Append(std::move(item));
+  }
+
+  base::Value val;
+  ASSERT_TRUE(RLPDecode(RLPEncode(list.Clone()), &val));
+  EXPECT_EQ(list, val);
+}
+
+TEST(RLPDecodeTest, InvalidInputTruncatedNestedList) {
+  // ["cat", ["dog", "horse"], "", [[]]]
+  const std::string input =
+      FromHex("0xd283636174ca83646f6785686f72736580c1c0");
+  base::Value val;
+  ASSERT_TRUE(RLPDecode(input, &val));
+  EXPECT_EQ(RLPTestValueToString(val),
+            "['cat', ['dog', 'horse'], '', [[]]]");
+
+  for (size_t i = 0; i < input.size(); i++) {
+    SCOPED_TRACE(i);
+    ASSERT_FALSE(RLPDecode(input.substr(0, i), &val));
+    ASSERT_TRUE(val.is_none());
+  }
+}
+
+TEST(RLPDecodeTest, InvalidInputInnerLengthPastOuterList) {
+  // The outer list holds 4 bytes but the inner string claims 5.
+  base::Value val;
+  ASSERT_FALSE(RLPDecode(FromHex("0xc4856361740000"), &val));
+  ASSERT_TRUE(val.is_none());
+}
+
+TEST(RLPDecodeTest, InvalidInputNonCanonicalInnerString) {
+  // A single byte below 0x80 inside a list must not carry a length prefix.
+  base::Value val;
+  ASSERT_FALSE(RLPDecode(FromHex("0xc5820061810a"), &val));
+  ASSERT_TRUE(val.is_none());
+}
+
 }  // namespace brave_wallet
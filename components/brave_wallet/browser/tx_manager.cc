@@ -94,12 +94,31 @@ void TxManager::CheckIfBlockTrackerShouldRun() {
   bool locked = keyring_service_->IsLocked();
   bool running = block_tracker_->IsRunning();
   if (!locked && !running) {
-    block_tracker_->Start(base::Seconds(kBlockTrackerDefaultTimeInSeconds));
+    block_tracker_->Start(block_tracker_interval_);
   } else if ((locked || known_no_pending_tx_) && running) {
     block_tracker_->Stop();
+    block_tracker_interval_ = base::Seconds(kBlockTrackerDefaultTimeInSeconds);
   }
 }
 
+void TxManager::SpeedUpBlockTracker() {
+  SetBlockTrackerInterval(base::Seconds(kBlockTrackerSubmittedTxTimeInSeconds));
+}
+
+void TxManager::BackOffBlockTracker() {
+  SetBlockTrackerInterval(
+      std::min(block_tracker_interval_ * 2,
+               base::Seconds(kBlockTrackerDefaultTimeInSeconds)));
+}
+
+void TxManager::SetBlockTrackerInterval(base::TimeDelta interval) {
+  if (block_tracker_interval_ == interval)
+    return;
+  block_tracker_interval_ = interval;
+  if (block_tracker_->IsRunning())
+    block_tracker_->Start(block_tracker_interval_);
+}
+
 void TxManager::OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) {
   tx_service_->OnTransactionStatusChanged(tx_info->Clone());
 }
@@ -131,6 +150,7 @@ void TxManager::KeyringReset() {
 
 void TxManager::Reset() {
   block_tracker_->Stop();
+  block_tracker_interval_ = base::Seconds(kBlockTrackerDefaultTimeInSeconds);
   known_no_pending_tx_ = false;
 }
 
@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 
+#include "base/time/time.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -77,6 +79,10 @@ class TxManager : public TxStateManager::Observer,
 
  protected:
   void CheckIfBlockTrackerShouldRun();
+  // Polls for new blocks more often while a just submitted transaction is
+  // likely to be mined soon, then backs off to the default interval.
+  void SpeedUpBlockTracker();
+  void BackOffBlockTracker();
   virtual void UpdatePendingTransactions() = 0;
 
   std::unique_ptr<TxStateManager> tx_state_manager_;
@@ -86,8 +92,12 @@ class TxManager : public TxStateManager::Observer,
   raw_ptr<KeyringService> keyring_service_ = nullptr;   // NOT OWNED
   raw_ptr<PrefService> prefs_ = nullptr;                // NOT OWNED
   bool known_no_pending_tx_ = false;
+  base::TimeDelta block_tracker_interval_ =
+      base::Seconds(kBlockTrackerDefaultTimeInSeconds);
 
  private:
+  void SetBlockTrackerInterval(base::TimeDelta interval);
+
   // TxStateManager::Observer
   void OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) override;
   void OnNewUnapprovedTx(mojom::TransactionInfoPtr tx_info) override;
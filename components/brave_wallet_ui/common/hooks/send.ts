@@ -99,7 +99,7 @@ export default function useSend () {
     // If success true, will set toAddress else will return error message.
     if (endsWithAny(supportedENSExtensions, valueToLowerCase)) {
       findENSAddress(toAddressOrUrl).then((value: GetEthAddrReturnInfo) => {
-        if (value.error === BraveWallet.ProviderError.kSuccess) {
+        if (value.address && value.error === BraveWallet.ProviderError.kSuccess) {
           setAddressError('')
           setAddressWarning('')
           setToAddress(value.address)
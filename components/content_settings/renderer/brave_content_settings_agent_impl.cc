@@ -53,21 +53,17 @@ GURL GetOriginOrURL(const blink::WebFrame* frame) {
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
+ContentSetting GetContentSettingFromRules(
+    const ContentSettingsForOneType& rules,
+    const GURL& primary_url,
+    const GURL& secondary_url) {
   for (const auto& rule : rules) {
     if (rule.primary_pattern.Matches(primary_url) &&
         rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
-      break;
+      return rule.GetContentSetting();
     }
   }
-
-  return setting == CONTENT_SETTING_BLOCK;
+  return CONTENT_SETTING_DEFAULT;
 }
 
 }  // namespace
@@ -123,11 +119,10 @@ bool BraveContentSettingsAgentImpl::AllowScript(bool enabled_per_settings) {
   // without calling `AllowScriptFromSource` first
   blocked_script_url_ = GURL::EmptyGURL();
 
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
+  const GURL& secondary_url = GetShieldsDecisions().frame_url;
 
   bool allow = ContentSettingsAgentImpl::AllowScript(enabled_per_settings);
-  allow = allow || IsBraveShieldsDown(frame, secondary_url) ||
+  allow = allow || IsBraveShieldsDown(secondary_url) ||
           IsScriptTemporilyAllowed(secondary_url);
 
   if (!allow) {
@@ -214,7 +209,7 @@ bool BraveContentSettingsAgentImpl::AllowScriptFromSource(
       render_frame()->GetWebFrame()->GetDocument().Url());
 
   allow = allow || should_white_list ||
-          IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
+          IsBraveShieldsDown(secondary_url) ||
           IsScriptTemporilyAllowed(secondary_url);
 
   if (!allow) {
@@ -224,93 +219,104 @@ bool BraveContentSettingsAgentImpl::AllowScriptFromSource(
   return allow;
 }
 
+BraveContentSettingsAgentImpl::ShieldsDecisions::ShieldsDecisions() = default;
+
+BraveContentSettingsAgentImpl::ShieldsDecisions::~ShieldsDecisions() = default;
+
+const BraveContentSettingsAgentImpl::ShieldsDecisions&
+BraveContentSettingsAgentImpl::GetShieldsDecisions() {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  url::Origin frame_origin(frame->GetSecurityOrigin());
+  if (shields_decisions_ && shields_decisions_->frame_origin == frame_origin)
+    return *shields_decisions_;
+
+  shields_decisions_.emplace();
+  ShieldsDecisions& decisions = *shields_decisions_;
+  decisions.frame_origin = std::move(frame_origin);
+  decisions.frame_url = decisions.frame_origin.GetURL();
+  if (!content_setting_rules_) {
+    // Shields are down, farbling is balanced and cosmetic filtering is off.
+    return decisions;
+  }
+
+  decisions.primary_url = GetOriginOrURL(frame);
+  const GURL& primary_url = decisions.primary_url;
+  for (const auto& rule : content_setting_rules_->brave_shields_rules) {
+    if (rule.primary_pattern.Matches(primary_url))
+      decisions.shields_rules.push_back(rule);
+  }
+  decisions.shields_down =
+      GetContentSettingFromRules(decisions.shields_rules, primary_url,
+                                 decisions.frame_url) == CONTENT_SETTING_BLOCK;
+
+  const ContentSetting fingerprinting_setting =
+      decisions.shields_down
+          ? CONTENT_SETTING_ALLOW
+          : brave_shields::GetBraveFPContentSettingFromRules(
+                content_setting_rules_->fingerprinting_rules, primary_url);
+  if (fingerprinting_setting == CONTENT_SETTING_BLOCK)
+    decisions.farbling_level = BraveFarblingLevel::MAXIMUM;
+  else if (fingerprinting_setting == CONTENT_SETTING_ALLOW)
+    decisions.farbling_level = BraveFarblingLevel::OFF;
+
+  decisions.cosmetic_filtering_enabled =
+      base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockCosmeticFiltering) &&
+      GetContentSettingFromRules(decisions.shields_rules, primary_url,
+                                 GURL()) != CONTENT_SETTING_BLOCK &&
+      GetContentSettingFromRules(
+          content_setting_rules_->cosmetic_filtering_rules, primary_url,
+          GURL()) != CONTENT_SETTING_ALLOW;
+  decisions.first_party_cosmetic_filtering_enabled =
+      GetContentSettingFromRules(
+          content_setting_rules_->cosmetic_filtering_rules, primary_url,
+          GURL("https://firstParty/")) == CONTENT_SETTING_BLOCK;
+
+  return decisions;
+}
+
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
-    const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+  if (!content_setting_rules_)
+    return true;
+
+  const ShieldsDecisions& decisions = GetShieldsDecisions();
+  if (secondary_url == decisions.frame_url)
+    return decisions.shields_down;
+  return GetContentSettingFromRules(decisions.shields_rules,
+                                    decisions.primary_url,
+                                    secondary_url) == CONTENT_SETTING_BLOCK;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting() {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
+  const ShieldsDecisions& decisions = GetShieldsDecisions();
+  if (decisions.shields_down)
     return true;
-  }
 
-  return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
+  return decisions.farbling_level != BraveFarblingLevel::MAXIMUM;
 }
 
 bool BraveContentSettingsAgentImpl::IsCosmeticFilteringEnabled(
     const GURL& url) {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  GURL secondary_url = GURL();
-
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
-    const GURL& primary_url = GetOriginOrURL(frame);
-
-    for (const auto& rule : content_setting_rules_->cosmetic_filtering_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
-    }
-  }
-
-  return base::FeatureList::IsEnabled(
-             brave_shields::features::kBraveAdblockCosmeticFiltering) &&
-         !IsBraveShieldsDown(frame, secondary_url) &&
-         (setting != CONTENT_SETTING_ALLOW);
+  return GetShieldsDecisions().cosmetic_filtering_enabled;
 }
 
 bool BraveContentSettingsAgentImpl::IsFirstPartyCosmeticFilteringEnabled(
     const GURL& url) {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  GURL secondary_url = GURL("https://firstParty/");
-
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
-    const GURL& primary_url = GetOriginOrURL(frame);
-
-    for (const auto& rule : content_setting_rules_->cosmetic_filtering_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
-    }
-  }
-
-  return setting == CONTENT_SETTING_BLOCK;
+  return GetShieldsDecisions().first_party_cosmetic_filtering_enabled;
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
-      setting = CONTENT_SETTING_ALLOW;
-    } else {
-      setting = brave_shields::GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
-    }
-  }
-
-  if (setting == CONTENT_SETTING_BLOCK) {
+  const BraveFarblingLevel farbling_level =
+      GetShieldsDecisions().farbling_level;
+  if (farbling_level == BraveFarblingLevel::MAXIMUM) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
-  } else if (setting == CONTENT_SETTING_ALLOW) {
+  } else if (farbling_level == BraveFarblingLevel::OFF) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
   }
+  return farbling_level;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
@@ -350,6 +356,18 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
   return allow;
 }
 
+void BraveContentSettingsAgentImpl::SendRendererContentSettingRules(
+    const RendererContentSettingRules& renderer_settings) {
+  ContentSettingsAgentImpl::SendRendererContentSettingRules(renderer_settings);
+  shields_decisions_.reset();
+}
+
+void BraveContentSettingsAgentImpl::SetRendererContentSettingRulesForTest(
+    const RendererContentSettingRules& rules) {
+  ContentSettingsAgentImpl::SetRendererContentSettingRulesForTest(rules);
+  shields_decisions_.reset();
+}
+
 void BraveContentSettingsAgentImpl::SetAllowScriptsFromOriginsOnce(
     const std::vector<std::string>& origins) {
   temporarily_allowed_scripts_ = origins;
@@ -21,8 +21,9 @@
 #include "mojo/public/cpp/bindings/associated_receiver_set.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
-
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
+#include "url/origin.h"
 
 namespace blink {
 class WebLocalFrame;
@@ -47,6 +48,10 @@ class BraveContentSettingsAgentImpl
 
   bool IsFirstPartyCosmeticFilteringEnabled(const GURL& url) override;
 
+  // Also drops the cached Shields decisions, which depend on the rules.
+  void SetRendererContentSettingRulesForTest(
+      const RendererContentSettingRules& rules);
+
  protected:
   bool AllowScript(bool enabled_per_settings) override;
   bool AllowScriptFromSource(bool enabled_per_settings,
@@ -71,12 +76,41 @@ class BraveContentSettingsAgentImpl
                            AutoplayBlockedByDefault);
   FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplAutoplayBrowserTest,
                            AutoplayAllowedByDefault);
-
-  bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                          const GURL& secondary_url);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplShieldsBrowserTest,
+                           DecisionsFollowNewRules);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplShieldsBrowserTest,
+                           AllowFingerprintingWithManyRules);
+
+  // Shields decisions for the frame, which only depend on the frame origin,
+  // the top frame and the content setting rules.
+  struct ShieldsDecisions {
+    ShieldsDecisions();
+    ~ShieldsDecisions();
+
+    url::Origin frame_origin;
+    GURL frame_url;
+    // URL of the top frame the rules are matched against.
+    GURL primary_url;
+    // The Brave Shields rules which apply to the top frame, in order.
+    ContentSettingsForOneType shields_rules;
+    bool shields_down = true;
+    BraveFarblingLevel farbling_level = BraveFarblingLevel::BALANCED;
+    bool cosmetic_filtering_enabled = false;
+    bool first_party_cosmetic_filtering_enabled = false;
+  };
+
+  // Computes the decisions on first use and again after a navigation to
+  // another origin or after new content setting rules arrive.
+  const ShieldsDecisions& GetShieldsDecisions();
+
+  bool IsBraveShieldsDown(const GURL& secondary_url);
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
+  // content_settings::mojom::ContentSettingsAgent.
+  void SendRendererContentSettingRules(
+      const RendererContentSettingRules& renderer_settings) override;
+
   // brave_shields::mojom::BraveShields.
   void SetAllowScriptsFromOriginsOnce(
       const std::vector<std::string>& origins) override;
@@ -104,6 +138,8 @@ class BraveContentSettingsAgentImpl
   base::flat_map<url::Origin, blink::WebSecurityOrigin>
       cached_ephemeral_storage_origins_;
 
+  absl::optional<ShieldsDecisions> shields_decisions_;
+
   mojo::AssociatedRemote<brave_shields::mojom::BraveShieldsHost>
       brave_shields_remote_;
 
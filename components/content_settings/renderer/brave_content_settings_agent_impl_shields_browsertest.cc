@@ -0,0 +1,121 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "components/content_settings/renderer/content_settings_agent_impl.h"
+#include "content/public/renderer/render_frame.h"
+#include "content/public/test/render_view_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+
+namespace content_settings {
+namespace {
+
+ContentSettingPatternSource CreateRule(const std::string& primary_pattern,
+                                       const std::string& secondary_pattern,
+                                       ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      ContentSettingToValue(setting), std::string(), false);
+}
+
+}  // namespace
+
+class BraveContentSettingsAgentImplShieldsBrowserTest
+    : public content::RenderViewTest {
+ protected:
+  void SetUp() override {
+    RenderViewTest::SetUp();
+
+    // Unbind the ContentSettingsAgent interface that would be registered by
+    // the ContentSettingsAgentImpl created when the render frame is created.
+    GetMainRenderFrame()->GetAssociatedInterfaceRegistry()->RemoveInterface(
+        mojom::ContentSettingsAgent::Name_);
+  }
+};
+
+TEST_F(BraveContentSettingsAgentImplShieldsBrowserTest,
+       DecisionsFollowNewRules) {
+  LoadHTMLWithUrlOverride("<html>Shields</html>", "https://example.com/");
+
+  BraveContentSettingsAgentImpl agent(
+      GetMainRenderFrame(), false,
+      std::make_unique<ContentSettingsAgentImpl::Delegate>());
+  // Shields are down until the rules arrive.
+  EXPECT_TRUE(agent.AllowFingerprinting());
+  EXPECT_EQ(BraveFarblingLevel::BALANCED, agent.GetBraveFarblingLevel());
+
+  RendererContentSettingRules rules;
+  rules.brave_shields_rules.push_back(
+      CreateRule("*", "*", CONTENT_SETTING_ALLOW));
+  rules.fingerprinting_rules.push_back(
+      CreateRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK));
+  agent.SendRendererContentSettingRules(rules);
+  EXPECT_FALSE(agent.AllowFingerprinting());
+  EXPECT_EQ(BraveFarblingLevel::MAXIMUM, agent.GetBraveFarblingLevel());
+
+  rules.fingerprinting_rules.front() =
+      CreateRule("[*.]example.com", "*", CONTENT_SETTING_ALLOW);
+  agent.SendRendererContentSettingRules(rules);
+  EXPECT_TRUE(agent.AllowFingerprinting());
+  EXPECT_EQ(BraveFarblingLevel::OFF, agent.GetBraveFarblingLevel());
+
+  // Turning Shields down for the site allows fingerprinting whatever the
+  // fingerprinting rules say.
+  rules.fingerprinting_rules.front() =
+      CreateRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK);
+  rules.brave_shields_rules.insert(
+      rules.brave_shields_rules.begin(),
+      CreateRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK));
+  agent.SendRendererContentSettingRules(rules);
+  EXPECT_TRUE(agent.AllowFingerprinting());
+  EXPECT_EQ(BraveFarblingLevel::OFF, agent.GetBraveFarblingLevel());
+
+  // Rules set directly by tests also replace the decisions.
+  rules.brave_shields_rules.erase(rules.brave_shields_rules.begin());
+  agent.SetRendererContentSettingRulesForTest(rules);
+  EXPECT_FALSE(agent.AllowFingerprinting());
+  EXPECT_EQ(BraveFarblingLevel::MAXIMUM, agent.GetBraveFarblingLevel());
+}
+
+TEST_F(BraveContentSettingsAgentImplShieldsBrowserTest,
+       AllowFingerprintingWithManyRules) {
+  constexpr int kRulesCount = 10000;
+  constexpr int kCallsCount = 1000000;
+
+  LoadHTMLWithUrlOverride("<html>Shields</html>", "https://example.com/");
+
+  RendererContentSettingRules rules;
+  for (int i = 0; i < kRulesCount; ++i) {
+    const std::string pattern = "[*.]site" + base::NumberToString(i) + ".com";
+    rules.brave_shields_rules.push_back(
+        CreateRule(pattern, "*", CONTENT_SETTING_BLOCK));
+    rules.fingerprinting_rules.push_back(
+        CreateRule(pattern, "*", CONTENT_SETTING_ALLOW));
+  }
+  rules.brave_shields_rules.push_back(
+      CreateRule("*", "*", CONTENT_SETTING_ALLOW));
+  rules.fingerprinting_rules.push_back(
+      CreateRule("*", "*", CONTENT_SETTING_BLOCK));
+
+  BraveContentSettingsAgentImpl agent(
+      GetMainRenderFrame(), false,
+      std::make_unique<ContentSettingsAgentImpl::Delegate>());
+  agent.SendRendererContentSettingRules(rules);
+
+  bool allowed = false;
+  for (int i = 0; i < kCallsCount; ++i)
+    allowed |= agent.AllowFingerprinting();
+  EXPECT_FALSE(allowed);
+}
+
+}  // namespace content_settings
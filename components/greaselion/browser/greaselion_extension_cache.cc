@@ -0,0 +1,399 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_extension_cache.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/values.h"
+#include "brave/components/brave_component_updater/browser/features.h"
+#include "brave/components/brave_component_updater/browser/switches.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "brave/components/update_client/buildflags.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
+#include "extensions/browser/computed_hashes.h"
+#include "extensions/common/api/content_scripts.h"
+#include "extensions/common/constants.h"
+#include "extensions/common/extension.h"
+#include "extensions/common/file_util.h"
+#include "extensions/common/manifest_constants.h"
+#include "extensions/common/mojom/manifest.mojom.h"
+
+using extensions::Extension;
+using extensions::mojom::ManifestLocation;
+
+namespace greaselion {
+
+namespace {
+
+constexpr char kRunAtDocumentStart[] = "document_start";
+constexpr char kCacheDirectoryName[] = "Extensions";
+
+// Bump this when the layout of generated extensions changes in a way which is
+// not reflected by the manifest, to stop reusing extensions generated by
+// previous versions.
+constexpr char kCacheVersion[] = "1";
+
+// Counts the cache instances using each extension directory. Profiles share
+// the install directory, so a profile must not prune an extension which was
+// loaded by another profile, even if it was last touched long ago.
+class InUseExtensionDirs {
+ public:
+  static InUseExtensionDirs* GetInstance() {
+    static base::NoDestructor<InUseExtensionDirs> instance;
+    return instance.get();
+  }
+
+  void Add(const base::FilePath& extension_dir) {
+    base::AutoLock lock(lock_);
+    counts_[extension_dir]++;
+  }
+
+  void Remove(const base::FilePath& extension_dir) {
+    base::AutoLock lock(lock_);
+    auto it = counts_.find(extension_dir);
+    DCHECK(it != counts_.end());
+    if (--it->second == 0)
+      counts_.erase(it);
+  }
+
+  bool Contains(const base::FilePath& extension_dir) {
+    base::AutoLock lock(lock_);
+    return counts_.find(extension_dir) != counts_.end();
+  }
+
+ private:
+  base::Lock lock_;
+  std::map<base::FilePath, size_t> counts_;
+};
+
+bool ShouldComputeHashesForResource(
+    const base::FilePath& relative_resource_path) {
+  std::vector<base::FilePath::StringType> components =
+      relative_resource_path.GetComponents();
+  return !components.empty() && components[0] != extensions::kMetadataFolder;
+}
+
+std::unique_ptr<base::DictionaryValue> CreateManifest(
+    const GreaselionRule& rule) {
+  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
+
+  // manifest version is always 2
+  // see kModernManifestVersion in src/extensions/common/extension.cc
+  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
+
+  // Create the public key.
+  // Greaselion scripts are not signed, but the public key for an extension
+  // doubles as its unique identity, and we need one of those, so we add the
+  // rule name to a known Brave domain and hash the result to create a
+  // public key.
+  char raw[crypto::kSHA256Length] = {0};
+  std::string key;
+  std::string script_name = rule.name();
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    crypto::SHA256HashString(BUILDFLAG(UPDATER_DEV_ENDPOINT) + script_name, raw,
+                             crypto::kSHA256Length);
+  } else {
+    crypto::SHA256HashString(BUILDFLAG(UPDATER_PROD_ENDPOINT) + script_name,
+                             raw, crypto::kSHA256Length);
+  }
+  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+
+  root->SetStringPath(extensions::manifest_keys::kName, script_name);
+  root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
+  root->SetStringPath(extensions::manifest_keys::kDescription, "");
+  root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
+  root->SetStringPath("incognito",
+                      extensions::manifest_values::kIncognitoNotAllowed);
+
+  std::vector<std::string> matches;
+  matches.reserve(rule.url_patterns().size());
+  for (auto url_pattern : rule.url_patterns())
+    matches.push_back(url_pattern);
+
+  extensions::api::content_scripts::ContentScript content_script;
+  content_script.matches = std::move(matches);
+
+  content_script.js = std::make_unique<std::vector<std::string>>();
+  for (auto script : rule.scripts())
+    content_script.js->push_back(script.BaseName().AsUTF8Unsafe());
+
+  // All Greaselion scripts default to document end.
+  content_script.run_at =
+      rule.run_at() == kRunAtDocumentStart
+          ? extensions::api::content_scripts::RUN_AT_DOCUMENT_START
+          : extensions::api::content_scripts::RUN_AT_DOCUMENT_END;
+
+  if (!rule.messages().empty()) {
+    root->SetStringPath(extensions::manifest_keys::kDefaultLocale, "en_US");
+  }
+
+  auto content_scripts = std::make_unique<base::ListValue>();
+  content_scripts->Append(content_script.ToValue());
+
+  root->Set(extensions::api::content_scripts::ManifestKeys::kContentScripts,
+            std::move(content_scripts));
+
+  return root;
+}
+
+// Adds |data| prefixed with its size, so that the hashed sequence of values
+// is unambiguous.
+void AddToHash(crypto::SecureHash* hash, base::StringPiece data) {
+  const uint64_t size = data.size();
+  hash->Update(&size, sizeof(size));
+  hash->Update(data.data(), data.size());
+}
+
+bool AddFileToHash(crypto::SecureHash* hash,
+                   const std::string& name,
+                   const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+  AddToHash(hash, name);
+  AddToHash(hash, contents);
+  return true;
+}
+
+}  // namespace
+
+GreaselionExtensionCache::GreaselionExtensionCache(
+    const base::FilePath& install_directory)
+    : install_directory_(install_directory),
+      cache_directory_(install_directory.AppendASCII(kCacheDirectoryName)) {}
+
+GreaselionExtensionCache::~GreaselionExtensionCache() {
+  for (const auto& in_use : in_use_extension_dirs_)
+    InUseExtensionDirs::GetInstance()->Remove(in_use.second);
+}
+
+scoped_refptr<Extension> GreaselionExtensionCache::GetOrCreateExtension(
+    const GreaselionRule& rule) {
+  std::string manifest;
+  if (!base::JSONWriter::Write(*CreateManifest(rule), &manifest)) {
+    LOG(ERROR) << "Could not serialize Greaselion manifest";
+    return nullptr;
+  }
+
+  absl::optional<std::string> cache_key = GetCacheKey(rule, manifest);
+  if (!cache_key) {
+    LOG(ERROR) << "Could not read Greaselion rule files";
+    return nullptr;
+  }
+
+  const base::FilePath extension_dir = cache_directory_.AppendASCII(*cache_key);
+  if (base::DirectoryExists(extension_dir)) {
+    scoped_refptr<Extension> extension = LoadCachedExtension(extension_dir);
+    if (extension) {
+      SetExtensionInUse(rule.name(), extension_dir);
+      return extension;
+    }
+    // The cached extension is broken, generate it again.
+    base::DeletePathRecursively(extension_dir);
+  }
+
+  if (!CreateExtension(rule, manifest, extension_dir))
+    return nullptr;
+
+  std::string error;
+  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+      extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS, &error);
+  if (!extension.get()) {
+    LOG(ERROR) << "Could not load Greaselion extension";
+    LOG(ERROR) << error;
+    base::DeletePathRecursively(extension_dir);
+    return nullptr;
+  }
+  SetExtensionInUse(rule.name(), extension_dir);
+  return extension;
+}
+
+void GreaselionExtensionCache::DeleteStaleExtensions(base::TimeDelta max_age) {
+  const base::Time now = base::Time::Now();
+  base::FileEnumerator file_enum(cache_directory_, false,
+                                 base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath extension_dir = file_enum.Next(); !extension_dir.empty();
+       extension_dir = file_enum.Next()) {
+    if (now - file_enum.GetInfo().GetLastModifiedTime() > max_age &&
+        !InUseExtensionDirs::GetInstance()->Contains(extension_dir)) {
+      base::DeletePathRecursively(extension_dir);
+    }
+  }
+}
+
+absl::optional<std::string> GreaselionExtensionCache::GetCacheKey(
+    const GreaselionRule& rule,
+    const std::string& manifest) const {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  AddToHash(hash.get(), kCacheVersion);
+  AddToHash(hash.get(), manifest);
+
+  for (const auto& script : rule.scripts()) {
+    if (!AddFileToHash(hash.get(), script.BaseName().AsUTF8Unsafe(), script))
+      return absl::nullopt;
+  }
+
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator file_enum(rule.messages(), true,
+                                   base::FileEnumerator::FILES);
+    for (base::FilePath path = file_enum.Next(); !path.empty();
+         path = file_enum.Next()) {
+      message_files.push_back(std::move(path));
+    }
+    if (message_files.empty())
+      return absl::nullopt;
+    std::sort(message_files.begin(), message_files.end());
+
+    for (const auto& path : message_files) {
+      base::FilePath relative_path;
+      rule.messages().AppendRelativePath(path, &relative_path);
+      if (!AddFileToHash(hash.get(), relative_path.AsUTF8Unsafe(), path))
+        return absl::nullopt;
+    }
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::HexEncode(digest, sizeof(digest));
+}
+
+scoped_refptr<Extension> GreaselionExtensionCache::LoadCachedExtension(
+    const base::FilePath& extension_dir) {
+  // Extensions are only reused once their computed hashes were written.
+  if (!base::PathExists(
+          extensions::file_util::GetComputedHashesPath(extension_dir))) {
+    return nullptr;
+  }
+
+  std::string error;
+  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+      extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS, &error);
+  if (!extension.get()) {
+    LOG(ERROR) << "Could not load cached Greaselion extension: " << error;
+    return nullptr;
+  }
+
+  // Mark the extension as used so that it is not deleted as stale.
+  const base::Time now = base::Time::Now();
+  base::TouchFile(extension_dir, now, now);
+  return extension;
+}
+
+bool GreaselionExtensionCache::CreateExtension(
+    const GreaselionRule& rule,
+    const std::string& manifest,
+    const base::FilePath& extension_dir) {
+  base::FilePath install_temp_dir =
+      extensions::file_util::GetInstallTempDir(install_directory_);
+  if (install_temp_dir.empty()) {
+    LOG(ERROR) << "Could not get path to profile temp directory";
+    return false;
+  }
+
+  // The extension is generated in a temp directory and only moved to the cache
+  // once complete, so a partially written extension is never reused.
+  base::ScopedTempDir temp_dir;
+  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
+    LOG(ERROR) << "Could not create Greaselion temp directory";
+    return false;
+  }
+
+  if (!base::WriteFile(temp_dir.GetPath().Append(extensions::kManifestFilename),
+                       manifest)) {
+    LOG(ERROR) << "Could not write Greaselion manifest";
+    return false;
+  }
+  file_writes_count_++;
+
+  // Copy the messages directory to our extension directory.
+  if (!rule.messages().empty()) {
+    if (!base::CopyDirectory(rule.messages(),
+                             temp_dir.GetPath().AppendASCII("_locales"),
+                             true)) {
+      LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
+                 << rule.messages().LossyDisplayName();
+      return false;
+    }
+    file_writes_count_++;
+  }
+
+  // Copy the script files to our extension directory.
+  for (auto script : rule.scripts()) {
+    if (!base::CopyFile(script, temp_dir.GetPath().Append(script.BaseName()))) {
+      LOG(ERROR) << "Could not copy Greaselion script at path: "
+                 << script.LossyDisplayName();
+      return false;
+    }
+    file_writes_count_++;
+  }
+
+  // Calculate and write computed hashes.
+  absl::optional<extensions::ComputedHashes::Data> computed_hashes_data =
+      extensions::ComputedHashes::Compute(
+          temp_dir.GetPath(),
+          extension_misc::kContentVerificationDefaultBlockSize,
+          extensions::IsCancelledCallback(),
+          base::BindRepeating(&ShouldComputeHashesForResource));
+  computed_hashes_count_++;
+  if (!computed_hashes_data ||
+      !extensions::ComputedHashes(std::move(*computed_hashes_data))
+           .WriteToFile(extensions::file_util::GetComputedHashesPath(
+               temp_dir.GetPath()))) {
+    LOG(ERROR) << "Could not write Greaselion computed hashes";
+    return false;
+  }
+  file_writes_count_++;
+
+  if (!base::CreateDirectory(cache_directory_) ||
+      !base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension to "
+               << extension_dir.LossyDisplayName();
+    return false;
+  }
+  return true;
+}
+
+void GreaselionExtensionCache::SetExtensionInUse(
+    const std::string& rule_name,
+    const base::FilePath& extension_dir) {
+  InUseExtensionDirs* in_use_dirs = InUseExtensionDirs::GetInstance();
+  in_use_dirs->Add(extension_dir);
+  auto it = in_use_extension_dirs_.find(rule_name);
+  if (it == in_use_extension_dirs_.end()) {
+    in_use_extension_dirs_.emplace(rule_name, extension_dir);
+    return;
+  }
+  in_use_dirs->Remove(it->second);
+  it->second = extension_dir;
+}
+
+}  // namespace greaselion
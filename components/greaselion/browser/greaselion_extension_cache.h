@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_EXTENSION_CACHE_H_
+#define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_EXTENSION_CACHE_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace extensions {
+class Extension;
+}  // namespace extensions
+
+namespace greaselion {
+
+class GreaselionRule;
+
+// Keeps the component extensions generated for Greaselion rules in the install
+// directory, keyed by a hash of the generated manifest and the bytes of the
+// rule's scripts and messages. Rules which did not change since their
+// extension was generated reuse its directory and computed hashes, instead of
+// writing and hashing every file again on each update.
+//
+// NOTE: This class does file IO and should only be used on the extension file
+// task runner.
+class GreaselionExtensionCache {
+ public:
+  explicit GreaselionExtensionCache(const base::FilePath& install_directory);
+  GreaselionExtensionCache(const GreaselionExtensionCache&) = delete;
+  GreaselionExtensionCache& operator=(const GreaselionExtensionCache&) = delete;
+  ~GreaselionExtensionCache();
+
+  // Returns the extension wrapping |rule|, or nullptr if it could not be
+  // created.
+  scoped_refptr<extensions::Extension> GetOrCreateExtension(
+      const GreaselionRule& rule);
+
+  // Deletes cached extensions which have not been used for |max_age|. The
+  // install directory is shared by all profiles, so extensions which are still
+  // in use by any cache instance are kept regardless of their age.
+  void DeleteStaleExtensions(base::TimeDelta max_age);
+
+  size_t file_writes_count_for_testing() const { return file_writes_count_; }
+  size_t computed_hashes_count_for_testing() const {
+    return computed_hashes_count_;
+  }
+
+ private:
+  absl::optional<std::string> GetCacheKey(const GreaselionRule& rule,
+                                          const std::string& manifest) const;
+  scoped_refptr<extensions::Extension> LoadCachedExtension(
+      const base::FilePath& extension_dir);
+  bool CreateExtension(const GreaselionRule& rule,
+                       const std::string& manifest,
+                       const base::FilePath& extension_dir);
+  void SetExtensionInUse(const std::string& rule_name,
+                         const base::FilePath& extension_dir);
+
+  const base::FilePath install_directory_;
+  const base::FilePath cache_directory_;
+  // Directory of the extension last returned for each rule name.
+  std::map<std::string, base::FilePath> in_use_extension_dirs_;
+  size_t file_writes_count_ = 0;
+  size_t computed_hashes_count_ = 0;
+};
+
+}  // namespace greaselion
+
+#endif  // BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_EXTENSION_CACHE_H_
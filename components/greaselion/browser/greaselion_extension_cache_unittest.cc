@@ -0,0 +1,187 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_extension_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "extensions/common/extension.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace greaselion {
+
+class GreaselionExtensionCacheTest : public testing::Test {
+ public:
+  GreaselionExtensionCacheTest() = default;
+  ~GreaselionExtensionCacheTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    resource_dir_ = temp_dir_.GetPath().AppendASCII("resources");
+    ASSERT_TRUE(base::CreateDirectory(resource_dir_));
+    WriteScript("console.log('greaselion');");
+  }
+
+ protected:
+  void WriteScript(const std::string& contents) {
+    ASSERT_TRUE(
+        base::WriteFile(resource_dir_.AppendASCII("script.js"), contents));
+  }
+
+  GreaselionRule CreateRule(const std::string& name) {
+    base::ListValue urls;
+    urls.Append("https://www.example.com/*");
+    base::ListValue scripts;
+    scripts.Append("script.js");
+    GreaselionRule rule(name);
+    rule.Parse(nullptr, &urls, &scripts, "", "", base::FilePath(),
+               resource_dir_);
+    return rule;
+  }
+
+  base::FilePath install_directory() const {
+    return temp_dir_.GetPath().AppendASCII("Greaselion");
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath resource_dir_;
+};
+
+TEST_F(GreaselionExtensionCacheTest, RepeatedUpdatesReuseExtension) {
+  GreaselionExtensionCache cache(install_directory());
+  const GreaselionRule rule = CreateRule("greaselion-test");
+
+  scoped_refptr<extensions::Extension> extension =
+      cache.GetOrCreateExtension(rule);
+  ASSERT_TRUE(extension);
+  // Manifest, script and computed hashes.
+  EXPECT_EQ(3u, cache.file_writes_count_for_testing());
+  EXPECT_EQ(1u, cache.computed_hashes_count_for_testing());
+
+  for (int i = 0; i < 10; ++i) {
+    scoped_refptr<extensions::Extension> cached_extension =
+        cache.GetOrCreateExtension(rule);
+    ASSERT_TRUE(cached_extension);
+    EXPECT_EQ(extension->id(), cached_extension->id());
+    EXPECT_EQ(extension->path(), cached_extension->path());
+  }
+  EXPECT_EQ(3u, cache.file_writes_count_for_testing());
+  EXPECT_EQ(1u, cache.computed_hashes_count_for_testing());
+}
+
+TEST_F(GreaselionExtensionCacheTest, StartupReusesExtension) {
+  const GreaselionRule rule = CreateRule("greaselion-test");
+  base::FilePath extension_path;
+  {
+    GreaselionExtensionCache cache(install_directory());
+    scoped_refptr<extensions::Extension> extension =
+        cache.GetOrCreateExtension(rule);
+    ASSERT_TRUE(extension);
+    extension_path = extension->path();
+  }
+
+  GreaselionExtensionCache cache(install_directory());
+  scoped_refptr<extensions::Extension> extension =
+      cache.GetOrCreateExtension(rule);
+  ASSERT_TRUE(extension);
+  EXPECT_EQ(extension_path, extension->path());
+  EXPECT_EQ(0u, cache.file_writes_count_for_testing());
+  EXPECT_EQ(0u, cache.computed_hashes_count_for_testing());
+}
+
+TEST_F(GreaselionExtensionCacheTest, ChangedScriptCreatesExtension) {
+  GreaselionExtensionCache cache(install_directory());
+  scoped_refptr<extensions::Extension> extension =
+      cache.GetOrCreateExtension(CreateRule("greaselion-test"));
+  ASSERT_TRUE(extension);
+
+  WriteScript("console.log('greaselion updated');");
+  scoped_refptr<extensions::Extension> updated_extension =
+      cache.GetOrCreateExtension(CreateRule("greaselion-test"));
+  ASSERT_TRUE(updated_extension);
+  EXPECT_EQ(extension->id(), updated_extension->id());
+  EXPECT_NE(extension->path(), updated_extension->path());
+  EXPECT_EQ(2u, cache.computed_hashes_count_for_testing());
+
+  std::string script;
+  ASSERT_TRUE(base::ReadFileToString(
+      updated_extension->path().AppendASCII("script.js"), &script));
+  EXPECT_EQ("console.log('greaselion updated');", script);
+}
+
+TEST_F(GreaselionExtensionCacheTest, BrokenExtensionIsCreatedAgain) {
+  const GreaselionRule rule = CreateRule("greaselion-test");
+  GreaselionExtensionCache cache(install_directory());
+  scoped_refptr<extensions::Extension> extension =
+      cache.GetOrCreateExtension(rule);
+  ASSERT_TRUE(extension);
+
+  ASSERT_TRUE(base::DeleteFile(
+      extension->path().Append(extensions::kManifestFilename)));
+  scoped_refptr<extensions::Extension> recreated_extension =
+      cache.GetOrCreateExtension(rule);
+  ASSERT_TRUE(recreated_extension);
+  EXPECT_EQ(extension->path(), recreated_extension->path());
+  EXPECT_EQ(2u, cache.computed_hashes_count_for_testing());
+}
+
+TEST_F(GreaselionExtensionCacheTest, DeleteStaleExtensions) {
+  base::FilePath extension_path;
+  {
+    GreaselionExtensionCache cache(install_directory());
+    scoped_refptr<extensions::Extension> extension =
+        cache.GetOrCreateExtension(CreateRule("greaselion-test"));
+    ASSERT_TRUE(extension);
+    extension_path = extension->path();
+  }
+
+  GreaselionExtensionCache cache(install_directory());
+  cache.DeleteStaleExtensions(base::Days(1));
+  EXPECT_TRUE(base::DirectoryExists(extension_path));
+
+  const base::Time last_used = base::Time::Now() - base::Days(2);
+  ASSERT_TRUE(base::TouchFile(extension_path, last_used, last_used));
+  cache.DeleteStaleExtensions(base::Days(1));
+  EXPECT_FALSE(base::DirectoryExists(extension_path));
+}
+
+TEST_F(GreaselionExtensionCacheTest, DeleteStaleExtensionsKeepsInUse) {
+  auto profile_cache =
+      std::make_unique<GreaselionExtensionCache>(install_directory());
+  scoped_refptr<extensions::Extension> extension =
+      profile_cache->GetOrCreateExtension(CreateRule("greaselion-test"));
+  ASSERT_TRUE(extension);
+
+  // Another profile starting up must not prune the extension, even though it
+  // was last touched long ago.
+  const base::Time last_used = base::Time::Now() - base::Days(2);
+  ASSERT_TRUE(base::TouchFile(extension->path(), last_used, last_used));
+  GreaselionExtensionCache other_profile_cache(install_directory());
+  other_profile_cache.DeleteStaleExtensions(base::Days(1));
+  EXPECT_TRUE(base::DirectoryExists(extension->path()));
+
+  // Updating the rule releases the previous extension.
+  WriteScript("console.log('greaselion updated');");
+  scoped_refptr<extensions::Extension> updated_extension =
+      profile_cache->GetOrCreateExtension(CreateRule("greaselion-test"));
+  ASSERT_TRUE(updated_extension);
+  ASSERT_TRUE(base::TouchFile(updated_extension->path(), last_used, last_used));
+  other_profile_cache.DeleteStaleExtensions(base::Days(1));
+  EXPECT_FALSE(base::DirectoryExists(extension->path()));
+  EXPECT_TRUE(base::DirectoryExists(updated_extension->path()));
+
+  profile_cache.reset();
+  other_profile_cache.DeleteStaleExtensions(base::Days(1));
+  EXPECT_FALSE(base::DirectoryExists(updated_extension->path()));
+}
+
+}  // namespace greaselion
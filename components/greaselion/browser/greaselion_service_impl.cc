@@ -11,207 +11,31 @@
 #include <utility>
 #include <vector>
 
-#include "base/base64.h"
 #include "base/bind.h"
 #include "base/callback_helpers.h"
-#include "base/command_line.h"
-#include "base/feature_list.h"
 #include "base/files/file_path.h"
-#include "base/files/file_util.h"
-#include "base/files/scoped_temp_dir.h"
-#include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/task_runner_util.h"
-#include "base/values.h"
+#include "base/time/time.h"
 #include "base/version.h"
-#include "brave/components/brave_component_updater/browser/features.h"
-#include "brave/components/brave_component_updater/browser/switches.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
-#include "brave/components/update_client/buildflags.h"
+#include "brave/components/greaselion/browser/greaselion_extension_cache.h"
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
-#include "crypto/sha2.h"
-#include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/extension_system.h"
-#include "extensions/common/api/content_scripts.h"
-#include "extensions/common/constants.h"
 #include "extensions/common/extension.h"
-#include "extensions/common/file_util.h"
-#include "extensions/common/manifest_constants.h"
-#include "extensions/common/mojom/manifest.mojom.h"
-#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 using extensions::Extension;
-using extensions::mojom::ManifestLocation;
 
 namespace {
 
-constexpr char kRunAtDocumentStart[] = "document_start";
-
-bool ShouldComputeHashesForResource(
-    const base::FilePath& relative_resource_path) {
-  std::vector<base::FilePath::StringType> components =
-      relative_resource_path.GetComponents();
-  return !components.empty() && components[0] != extensions::kMetadataFolder;
-}
-
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
-//
-// NOTE: This function does file IO and should not be called on the UI thread.
-absl::optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
-    const greaselion::GreaselionRule& rule,
-    const base::FilePath& install_dir) {
-  base::FilePath install_temp_dir =
-      extensions::file_util::GetInstallTempDir(install_dir);
-  if (install_temp_dir.empty()) {
-    LOG(ERROR) << "Could not get path to profile temp directory";
-    return absl::nullopt;
-  }
-
-  base::ScopedTempDir temp_dir;
-  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
-    LOG(ERROR) << "Could not create Greaselion temp directory";
-    return absl::nullopt;
-  }
-
-  // Create the manifest
-  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
-
-  // manifest version is always 2
-  // see kModernManifestVersion in src/extensions/common/extension.cc
-  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
-
-  // Create the public key.
-  // Greaselion scripts are not signed, but the public key for an extension
-  // doubles as its unique identity, and we need one of those, so we add the
-  // rule name to a known Brave domain and hash the result to create a
-  // public key.
-  char raw[crypto::kSHA256Length] = {0};
-  std::string key;
-  std::string script_name = rule.name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(BUILDFLAG(UPDATER_DEV_ENDPOINT) + script_name, raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(BUILDFLAG(UPDATER_PROD_ENDPOINT) + script_name,
-                             raw, crypto::kSHA256Length);
-  }
-  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
-
-  root->SetStringPath(extensions::manifest_keys::kName, script_name);
-  root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
-  root->SetStringPath(extensions::manifest_keys::kDescription, "");
-  root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
-  root->SetStringPath("incognito",
-                      extensions::manifest_values::kIncognitoNotAllowed);
-
-  std::vector<std::string> matches;
-  matches.reserve(rule.url_patterns().size());
-  for (auto url_pattern : rule.url_patterns())
-    matches.push_back(url_pattern);
-
-  extensions::api::content_scripts::ContentScript content_script;
-  content_script.matches = std::move(matches);
-
-  content_script.js = std::make_unique<std::vector<std::string>>();
-  for (auto script : rule.scripts())
-    content_script.js->push_back(script.BaseName().AsUTF8Unsafe());
-
-  // All Greaselion scripts default to document end.
-  content_script.run_at =
-      rule.run_at() == kRunAtDocumentStart
-          ? extensions::api::content_scripts::RUN_AT_DOCUMENT_START
-          : extensions::api::content_scripts::RUN_AT_DOCUMENT_END;
-
-  if (!rule.messages().empty()) {
-    root->SetStringPath(extensions::manifest_keys::kDefaultLocale, "en_US");
-  }
-
-  auto content_scripts = std::make_unique<base::ListValue>();
-  content_scripts->Append(content_script.ToValue());
-
-  root->Set(extensions::api::content_scripts::ManifestKeys::kContentScripts,
-            std::move(content_scripts));
-
-  base::FilePath manifest_path =
-      temp_dir.GetPath().Append(extensions::kManifestFilename);
-  JSONFileValueSerializer serializer(manifest_path);
-  // If you read the header file for this function, it says not to use it
-  // outside unit tests because it writes to disk (which blocks the thread). I
-  // just want to assure you that it's okay. We want to write to disk here, and
-  // we're already on a task runner specifically for writing extension-related
-  // files to disk.
-  if (!serializer.Serialize(*root)) {
-    LOG(ERROR) << "Could not write Greaselion manifest";
-    return absl::nullopt;
-  }
-
-  // Copy the messages directory to our extension directory.
-  if (!rule.messages().empty()) {
-    if (!base::CopyDirectory(
-            rule.messages(),
-            temp_dir.GetPath().AppendASCII("_locales"), true)) {
-      LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
-                 << rule.messages().LossyDisplayName();
-      return absl::nullopt;
-    }
-  }
-
-  // Copy the script files to our extension directory.
-  for (auto script : rule.scripts()) {
-    if (!base::CopyFile(script,
-                        temp_dir.GetPath().Append(script.BaseName()))) {
-      LOG(ERROR) << "Could not copy Greaselion script at path: "
-          << script.LossyDisplayName();
-      return absl::nullopt;
-    }
-  }
-
-  std::string error;
-  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), ManifestLocation::kComponent, Extension::NO_FLAGS,
-      &error);
-  if (!extension.get()) {
-    LOG(ERROR) << "Could not load Greaselion extension";
-    LOG(ERROR) << error;
-    return absl::nullopt;
-  }
-
-  // Calculate and write computed hashes.
-  absl::optional<extensions::ComputedHashes::Data> computed_hashes_data =
-      extensions::ComputedHashes::Compute(
-          extension->path(),
-          extension_misc::kContentVerificationDefaultBlockSize,
-          extensions::IsCancelledCallback(),
-          base::BindRepeating(&ShouldComputeHashesForResource));
-  if (computed_hashes_data) {
-    extensions::ComputedHashes(std::move(*computed_hashes_data))
-        .WriteToFile(
-            extensions::file_util::GetComputedHashesPath(extension->path()));
-  }
-
-  // Take ownership of this temporary directory; the service will delete it on
-  // exit
-  return std::make_pair(extension, temp_dir.Take());
-}
-
-void DeleteExtensionDirs(const std::vector<base::FilePath>& extension_dirs) {
-  for (const auto& extension_dir : extension_dirs) {
-    base::DeletePathRecursively(extension_dir);
-  }
-}
+// Generated extensions which were not used for this long are deleted.
+constexpr base::TimeDelta kMaxExtensionCacheAge = base::Days(30);
 
 }  // namespace
 
@@ -233,6 +57,8 @@ GreaselionServiceImpl::GreaselionServiceImpl(
       update_pending_(false),
       pending_installs_(0),
       task_runner_(std::move(task_runner)),
+      extension_cache_(new GreaselionExtensionCache(install_directory_),
+                       base::OnTaskRunnerDeleter(task_runner_)),
       browser_version_(
           version_info::GetBraveVersionWithoutChromiumMajorVersion()),
       weak_factory_(this) {
@@ -242,6 +68,11 @@ GreaselionServiceImpl::GreaselionServiceImpl(
     state_[static_cast<GreaselionFeature>(i)] = false;
   // Static-value features
   state_[GreaselionFeature::SUPPORTS_MINIMUM_BRAVE_VERSION] = true;
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&GreaselionExtensionCache::DeleteStaleExtensions,
+                     base::Unretained(extension_cache_.get()),
+                     kMaxExtensionCacheAge));
 }
 
 GreaselionServiceImpl::~GreaselionServiceImpl() {}
@@ -249,8 +80,6 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {}
 void GreaselionServiceImpl::Shutdown() {
   download_service_->RemoveObserver(this);
   extension_registry_->RemoveObserver(this);
-  task_runner_->PostTask(FROM_HERE,
-                         base::BindOnce(&DeleteExtensionDirs, extension_dirs_));
 }
 
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
@@ -310,13 +139,15 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
   for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
     if (rule->Matches(state_, browser_version_) &&
         rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
+      // Convert script file to component extension, or reuse the one created
+      // for the same rule before. This must run on extension file task runner,
+      // which was passed in in the constructor.
       GreaselionRule rule_copy(*rule);
       base::PostTaskAndReplyWithResult(
           task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
+          base::BindOnce(&GreaselionExtensionCache::GetOrCreateExtension,
+                         base::Unretained(extension_cache_.get()),
+                         std::move(rule_copy)),
           base::BindOnce(&GreaselionServiceImpl::PostConvert,
                          weak_factory_.GetWeakPtr()));
     }
@@ -324,19 +155,18 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
 }
 
 void GreaselionServiceImpl::PostConvert(
-    absl::optional<GreaselionConvertedExtension> converted_extension) {
-  if (!converted_extension) {
+    scoped_refptr<extensions::Extension> extension) {
+  if (!extension) {
     all_rules_installed_successfully_ = false;
     pending_installs_ -= 1;
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(converted_extension->second);
+    greaselion_extensions_.push_back(extension->id());
     extension_system_->ready().Post(
-        FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
-                                  weak_factory_.GetWeakPtr(),
-                                  std::move(converted_extension->first)));
+        FROM_HERE,
+        base::BindOnce(&GreaselionServiceImpl::Install,
+                       weak_factory_.GetWeakPtr(), std::move(extension)));
   }
 }
 
@@ -7,12 +7,13 @@
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 
 #include <map>
+#include <memory>
 #include <string>
-#include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
 #include "base/task/sequenced_task_runner.h"
@@ -20,7 +21,6 @@
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
-#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace base {
@@ -36,6 +36,8 @@ class ExtensionSystem;
 
 namespace greaselion {
 
+class GreaselionExtensionCache;
+
 class GreaselionServiceImpl : public GreaselionService,
                               public GreaselionDownloadService::Observer {
  public:
@@ -68,14 +70,10 @@ class GreaselionServiceImpl : public GreaselionService,
                            const extensions::Extension* extension,
                            extensions::UnloadedExtensionReason reason) override;
 
-  using GreaselionConvertedExtension =
-      std::pair<scoped_refptr<extensions::Extension>, base::FilePath>;
-
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
   void CreateAndInstallExtensions();
-  void PostConvert(
-      absl::optional<GreaselionConvertedExtension> converted_extension);
+  void PostConvert(scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -96,9 +94,11 @@ class GreaselionServiceImpl : public GreaselionService,
   bool update_pending_;
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Used and deleted on |task_runner_|.
+  std::unique_ptr<GreaselionExtensionCache, base::OnTaskRunnerDeleter>
+      extension_cache_;
   base::ObserverList<GreaselionService::Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::FilePath> extension_dirs_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 };
@@ -0,0 +1,160 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/ipfs_folder_import_plan.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+
+namespace {
+
+using ipfs::ImportFileInfo;
+
+// Part of a folder which is added to the folder as a whole: either a file or
+// a directory with everything below it.
+struct ImportUnit {
+  std::string relative_path;
+  // Split directories leading to this unit.
+  std::vector<ImportFileInfo> parents;
+  std::vector<ImportFileInfo> entries;
+  size_t file_count = 0;
+  int64_t size = 0;
+};
+
+std::string GetRelativePath(const base::FilePath& folder_path,
+                            const base::FilePath& path) {
+  base::FilePath relative_path;
+  if (!folder_path.AppendRelativePath(path, &relative_path))
+    return std::string();
+  return relative_path.NormalizePathSeparatorsTo('/').AsUTF8Unsafe();
+}
+
+void CollectImportUnits(const base::FilePath& folder_path,
+                        const base::FilePath& dir_path,
+                        const std::vector<ImportFileInfo>& parents,
+                        size_t max_files,
+                        int64_t max_size,
+                        std::vector<ImportUnit>* units,
+                        std::vector<std::string>* split_directories) {
+  std::vector<ImportFileInfo> children;
+  base::FileEnumerator file_enum(
+      dir_path, false,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath enum_path = file_enum.Next(); !enum_path.empty();
+       enum_path = file_enum.Next()) {
+    // Skip symlinks.
+    if (base::IsLink(enum_path))
+      continue;
+    children.push_back(ImportFileInfo(enum_path, file_enum.GetInfo()));
+  }
+  std::sort(children.begin(), children.end(),
+            [](const ImportFileInfo& a, const ImportFileInfo& b) {
+              return a.path < b.path;
+            });
+
+  for (const auto& child : children) {
+    ImportUnit unit;
+    unit.relative_path = GetRelativePath(folder_path, child.path);
+    unit.parents = parents;
+    unit.entries.push_back(child);
+    if (!child.info.IsDirectory()) {
+      unit.file_count = 1;
+      unit.size = child.info.GetSize();
+      units->push_back(std::move(unit));
+      continue;
+    }
+
+    // Stop as soon as the directory is known not to fit, so a large tree is
+    // neither held in memory nor enumerated again for each of its levels.
+    bool fits = true;
+    base::FileEnumerator dir_enum(
+        child.path, true,
+        base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath enum_path = dir_enum.Next(); !enum_path.empty();
+         enum_path = dir_enum.Next()) {
+      // Skip symlinks.
+      if (base::IsLink(enum_path))
+        continue;
+      ImportFileInfo entry(enum_path, dir_enum.GetInfo());
+      if (!entry.info.IsDirectory()) {
+        unit.file_count++;
+        unit.size += entry.info.GetSize();
+        if (unit.file_count > max_files || unit.size > max_size) {
+          fits = false;
+          break;
+        }
+      }
+      unit.entries.push_back(std::move(entry));
+    }
+    if (fits) {
+      units->push_back(std::move(unit));
+      continue;
+    }
+
+    // The directory does not fit into a single batch, add its children
+    // separately.
+    split_directories->push_back(unit.relative_path);
+    std::vector<ImportFileInfo> child_parents = parents;
+    child_parents.push_back(child);
+    CollectImportUnits(folder_path, child.path, child_parents, max_files,
+                       max_size, units, split_directories);
+  }
+}
+
+}  // namespace
+
+namespace ipfs {
+
+ImportFolderBatch::ImportFolderBatch() = default;
+ImportFolderBatch::ImportFolderBatch(const ImportFolderBatch&) = default;
+ImportFolderBatch& ImportFolderBatch::operator=(const ImportFolderBatch&) =
+    default;
+ImportFolderBatch::~ImportFolderBatch() = default;
+
+ImportFolderPlan::ImportFolderPlan() = default;
+ImportFolderPlan::ImportFolderPlan(const ImportFolderPlan&) = default;
+ImportFolderPlan& ImportFolderPlan::operator=(const ImportFolderPlan&) =
+    default;
+ImportFolderPlan::~ImportFolderPlan() = default;
+
+ImportFolderPlan CreateImportFolderPlan(const base::FilePath& folder_path,
+                                        size_t max_files,
+                                        int64_t max_size) {
+  std::vector<ImportUnit> units;
+  ImportFolderPlan plan;
+  CollectImportUnits(folder_path, folder_path, {}, max_files, max_size, &units,
+                     &plan.split_directories);
+
+  base::flat_set<base::FilePath> batch_parents;
+  for (auto& unit : units) {
+    if (plan.batches.empty() ||
+        (plan.batches.back().file_count > 0 &&
+         (plan.batches.back().file_count + unit.file_count > max_files ||
+          plan.batches.back().size + unit.size > max_size))) {
+      plan.batches.emplace_back();
+      batch_parents.clear();
+    }
+    auto& batch = plan.batches.back();
+    for (auto& parent : unit.parents) {
+      if (batch_parents.insert(parent.path).second)
+        batch.entries.push_back(std::move(parent));
+    }
+    std::move(unit.entries.begin(), unit.entries.end(),
+              std::back_inserter(batch.entries));
+    batch.units.push_back(std::move(unit.relative_path));
+    batch.file_count += unit.file_count;
+    batch.size += unit.size;
+  }
+  return plan;
+}
+
+}  // namespace ipfs
@@ -0,0 +1,54 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORT_PLAN_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORT_PLAN_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "brave/components/ipfs/ipfs_network_utils.h"
+
+namespace ipfs {
+
+// A group of files of a folder which is uploaded with a single add request.
+struct ImportFolderBatch {
+  ImportFolderBatch();
+  ImportFolderBatch(const ImportFolderBatch&);
+  ImportFolderBatch& operator=(const ImportFolderBatch&);
+  ~ImportFolderBatch();
+
+  // Entries to upload, including the directories leading to them.
+  std::vector<ImportFileInfo> entries;
+  // Paths, relative to the imported folder, of the files and whole
+  // directories this batch adds to the folder.
+  std::vector<std::string> units;
+  size_t file_count = 0;
+  int64_t size = 0;
+};
+
+// Splits a folder import into batches of at most |max_files| files and
+// |max_size| bytes, a single file exceeding the limits gets its own batch.
+// Directories which do not fit into a batch are split and recreated while
+// composing the folder from the batches.
+struct ImportFolderPlan {
+  ImportFolderPlan();
+  ImportFolderPlan(const ImportFolderPlan&);
+  ImportFolderPlan& operator=(const ImportFolderPlan&);
+  ~ImportFolderPlan();
+
+  std::vector<ImportFolderBatch> batches;
+  // Paths, relative to the imported folder, of the split directories.
+  std::vector<std::string> split_directories;
+};
+
+ImportFolderPlan CreateImportFolderPlan(const base::FilePath& folder_path,
+                                        size_t max_files,
+                                        int64_t max_size);
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORT_PLAN_H_
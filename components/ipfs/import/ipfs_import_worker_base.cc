@@ -42,6 +42,17 @@
 
 namespace {
 
+constexpr size_t kImportFolderMaxBatchFiles = 512;
+constexpr int64_t kImportFolderMaxBatchSize = 256 * 1024 * 1024;
+constexpr size_t kImportFolderMaxParallelRequests = 2;
+constexpr int kImportFolderMaxBatchAttempts = 3;
+
+int GetResponseCode(network::SimpleURLLoader* url_loader) {
+  if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
+    return url_loader->ResponseInfo()->headers->response_code();
+  return -1;
+}
+
 // Return a date string formatted as "YYYY-MM-DD".
 std::string TimeFormatDate(const base::Time& time) {
   base::Time::Exploded exploded_time;
@@ -65,6 +76,9 @@ IpfsImportWorkerBase::IpfsImportWorkerBase(
       url_loader_factory_(url_loader_factory),
       server_endpoint_(endpoint),
       key_to_publish_(key),
+      max_batch_files_(kImportFolderMaxBatchFiles),
+      max_batch_size_(kImportFolderMaxBatchSize),
+      max_parallel_requests_(kImportFolderMaxParallelRequests),
       weak_factory_(this) {
   DCHECK(endpoint.is_valid());
   data_.reset(new ipfs::ImportedData());
@@ -93,11 +107,31 @@ void IpfsImportWorkerBase::ImportFile(const base::FilePath upload_file_path,
 }
 
 void IpfsImportWorkerBase::ImportFolder(const base::FilePath folder_path) {
-  auto upload_callback = base::BindOnce(&IpfsImportWorkerBase::UploadData,
-                                        weak_factory_.GetWeakPtr());
+  folder_path_ = folder_path;
   data_->filename = folder_path.BaseName().MaybeAsASCII();
-  CreateRequestForFolder(folder_path, blob_context_getter_factory_,
-                         std::move(upload_callback));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(&CreateImportFolderPlan, folder_path, max_batch_files_,
+                     max_batch_size_),
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderImportPlanned,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void IpfsImportWorkerBase::SetFolderImportLimits(size_t max_batch_files,
+                                                 int64_t max_batch_size,
+                                                 size_t max_parallel_requests) {
+  DCHECK(folder_path_.empty());
+  DCHECK_GT(max_batch_files, 0u);
+  DCHECK_GT(max_batch_size, 0);
+  DCHECK_GT(max_parallel_requests, 0u);
+  max_batch_files_ = max_batch_files;
+  max_batch_size_ = max_batch_size;
+  max_parallel_requests_ = max_parallel_requests;
+}
+
+void IpfsImportWorkerBase::SetProgressCallback(
+    ImportProgressCallback callback) {
+  progress_callback_ = std::move(callback);
 }
 
 void IpfsImportWorkerBase::ImportText(const std::string& text,
@@ -117,6 +151,15 @@ void IpfsImportWorkerBase::ImportText(const std::string& text,
                        std::move(upload_callback));
 }
 
+GURL IpfsImportWorkerBase::GetImportAddUrl() const {
+  GURL url = net::AppendQueryParameter(server_endpoint_.Resolve(kImportAddPath),
+                                       "stream-channels", "true");
+  url = net::AppendQueryParameter(url, "wrap-with-directory", "true");
+  url = net::AppendQueryParameter(url, "pin", "false");
+  url = net::AppendQueryParameter(url, "progress", "false");
+  return url;
+}
+
 void IpfsImportWorkerBase::UploadData(
     std::unique_ptr<network::ResourceRequest> request) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -125,14 +168,8 @@ void IpfsImportWorkerBase::UploadData(
   if (!server_endpoint_.is_valid())
     return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
 
-  GURL url = net::AppendQueryParameter(server_endpoint_.Resolve(kImportAddPath),
-                                       "stream-channels", "true");
-  url = net::AppendQueryParameter(url, "wrap-with-directory", "true");
-  url = net::AppendQueryParameter(url, "pin", "false");
-  url = net::AppendQueryParameter(url, "progress", "false");
-
   DCHECK(!url_loader_);
-  url_loader_ = CreateURLLoader(url, "POST", std::move(request));
+  url_loader_ = CreateURLLoader(GetImportAddUrl(), "POST", std::move(request));
 
   url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_,
@@ -181,6 +218,231 @@ void IpfsImportWorkerBase::OnImportAddComplete(
   NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
 }
 
+void IpfsImportWorkerBase::OnFolderImportPlanned(ImportFolderPlan plan) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (plan.batches.empty())
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_REQUEST_EMPTY);
+  if (!server_endpoint_.is_valid())
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+
+  folder_plan_ = std::move(plan);
+  const size_t batch_count = folder_plan_.batches.size();
+  batch_hashes_.assign(batch_count, std::string());
+  batch_attempts_.assign(batch_count, 0);
+  for (size_t i = 0; i < batch_count; i++)
+    pending_batches_.push(i);
+  VLOG(1) << "Importing " << data_->filename << " in " << batch_count
+          << " batches";
+  UploadNextFolderBatches();
+}
+
+void IpfsImportWorkerBase::UploadNextFolderBatches() {
+  while (!pending_batches_.empty() &&
+         folder_loaders_.size() + pending_batch_requests_ <
+             max_parallel_requests_) {
+    const size_t index = pending_batches_.front();
+    pending_batches_.pop();
+    batch_attempts_[index]++;
+    pending_batch_requests_++;
+    CreateRequestForFileList(
+        base::BindOnce(&IpfsImportWorkerBase::UploadFolderBatch,
+                       weak_factory_.GetWeakPtr(), index),
+        blob_context_getter_factory_, folder_path_,
+        folder_plan_.batches[index].entries);
+  }
+}
+
+void IpfsImportWorkerBase::UploadFolderBatch(
+    size_t index,
+    std::unique_ptr<network::ResourceRequest> request) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_GT(pending_batch_requests_, 0u);
+  pending_batch_requests_--;
+  if (!request) {
+    CancelFolderImport();
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_REQUEST_EMPTY);
+  }
+
+  auto iter = folder_loaders_.insert(
+      folder_loaders_.end(),
+      CreateURLLoader(GetImportAddUrl(), "POST", std::move(request)));
+  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderBatchUploaded,
+                     weak_factory_.GetWeakPtr(), iter, index));
+}
+
+void IpfsImportWorkerBase::OnFolderBatchUploaded(
+    SimpleURLLoaderList::iterator iter,
+    size_t index,
+    std::unique_ptr<std::string> response_body) {
+  int error_code = iter->get()->NetError();
+  int response_code = GetResponseCode(iter->get());
+  folder_loaders_.erase(iter);
+
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  ipfs::ImportedData batch_data;
+  batch_data.filename = data_->filename;
+  if (success)
+    success = ParseResponseBody(*response_body, &batch_data);
+  if (!success || batch_data.hash.empty()) {
+    VLOG(1) << "Batch " << index << " failed, error_code:" << error_code
+            << " response_code:" << response_code;
+    if (batch_attempts_[index] >= kImportFolderMaxBatchAttempts) {
+      CancelFolderImport();
+      return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+    }
+    // Retry only the failed batch, completed batches are kept.
+    pending_batches_.push(index);
+    UploadNextFolderBatches();
+    return;
+  }
+
+  batch_hashes_[index] = batch_data.hash;
+  completed_batches_++;
+  if (progress_callback_)
+    progress_callback_.Run(completed_batches_, batch_hashes_.size());
+
+  if (completed_batches_ < batch_hashes_.size()) {
+    UploadNextFolderBatches();
+    return;
+  }
+
+  // A folder which fits into a single batch doesn't need to be composed.
+  if (batch_hashes_.size() == 1u) {
+    data_->hash = batch_hashes_.front();
+    data_->size = batch_data.size;
+    CreateBraveDirectory();
+    return;
+  }
+  ComposeFolder();
+}
+
+void IpfsImportWorkerBase::CancelFolderImport() {
+  // Drop callbacks of requests which are still running or being created.
+  weak_factory_.InvalidateWeakPtrs();
+  folder_loaders_.clear();
+  pending_batches_ = {};
+  compose_requests_ = {};
+}
+
+void IpfsImportWorkerBase::ComposeFolder() {
+  staging_directory_ =
+      base::StrCat({kImportDirectory, ".staging-", base::GenerateGUID()});
+  const std::string folder = staging_directory_ + "/" + data_->filename;
+
+  const GURL mkdir_url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportMakeDirectoryPath), "parents", "true");
+  compose_requests_.push(net::AppendQueryParameter(mkdir_url, "arg", folder));
+  for (const auto& directory : folder_plan_.split_directories) {
+    compose_requests_.push(
+        net::AppendQueryParameter(mkdir_url, "arg", folder + "/" + directory));
+  }
+  // Directories must exist before anything is copied into them.
+  compose_requests_.push(absl::nullopt);
+
+  const GURL copy_url = server_endpoint_.Resolve(kImportCopyPath);
+  for (size_t i = 0; i < folder_plan_.batches.size(); i++) {
+    for (const auto& unit : folder_plan_.batches[i].units) {
+      GURL url = net::AppendQueryParameter(
+          copy_url, "arg", "/ipfs/" + batch_hashes_[i] + "/" + unit);
+      url = net::AppendQueryParameter(url, "arg", folder + "/" + unit);
+      compose_requests_.push(url);
+    }
+  }
+  RunNextComposeRequests();
+}
+
+void IpfsImportWorkerBase::RunNextComposeRequests() {
+  DCHECK_EQ(pending_batch_requests_, 0u);
+  while (!compose_requests_.empty() &&
+         folder_loaders_.size() < max_parallel_requests_) {
+    if (!compose_requests_.front()) {
+      if (!folder_loaders_.empty())
+        return;
+      compose_requests_.pop();
+      continue;
+    }
+    auto iter = folder_loaders_.insert(
+        folder_loaders_.end(),
+        CreateURLLoader(*compose_requests_.front(), "POST"));
+    compose_requests_.pop();
+    iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+        url_loader_factory_,
+        base::BindOnce(&IpfsImportWorkerBase::OnComposeRequestComplete,
+                       weak_factory_.GetWeakPtr(), iter));
+  }
+  if (!compose_requests_.empty() || !folder_loaders_.empty())
+    return;
+
+  DCHECK(!url_loader_);
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportStatPath), "arg",
+      staging_directory_ + "/" + data_->filename);
+  url = net::AppendQueryParameter(url, "hash", "true");
+  url_loader_ = CreateURLLoader(url, "POST");
+  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnComposedFolderStat,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void IpfsImportWorkerBase::OnComposeRequestComplete(
+    SimpleURLLoaderList::iterator iter,
+    std::unique_ptr<std::string> response_body) {
+  int error_code = iter->get()->NetError();
+  int response_code = GetResponseCode(iter->get());
+  folder_loaders_.erase(iter);
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success) {
+    VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
+            << " response_body:" << *response_body;
+    CancelFolderImport();
+    return RemoveStagingDirectory(IPFS_IMPORT_ERROR_MOVE_FAILED);
+  }
+  RunNextComposeRequests();
+}
+
+void IpfsImportWorkerBase::OnComposedFolderStat(
+    std::unique_ptr<std::string> response_body) {
+  int error_code = url_loader_->NetError();
+  int response_code = GetResponseCode(url_loader_.get());
+  url_loader_.reset();
+  ipfs::ImportedData folder_data;
+  bool success =
+      (error_code == net::OK && response_code == net::HTTP_OK) &&
+      IPFSJSONParser::GetFilesStatFromJSON(*response_body, &folder_data);
+  if (!success || folder_data.hash.empty())
+    return RemoveStagingDirectory(IPFS_IMPORT_ERROR_MOVE_FAILED);
+  data_->hash = folder_data.hash;
+  data_->size = folder_data.size;
+
+  // The composed folder is copied by hash, the staging copy is not needed.
+  RemoveStagingDirectory(IPFS_IMPORT_SUCCESS);
+}
+
+void IpfsImportWorkerBase::RemoveStagingDirectory(ipfs::ImportState state) {
+  DCHECK(!url_loader_);
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportRemovePath), "arg", staging_directory_);
+  url = net::AppendQueryParameter(url, "recursive", "true");
+  url_loader_ = CreateURLLoader(url, "POST");
+  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnStagingDirectoryRemoved,
+                     weak_factory_.GetWeakPtr(), state));
+}
+
+void IpfsImportWorkerBase::OnStagingDirectoryRemoved(
+    ipfs::ImportState state,
+    std::unique_ptr<std::string> response_body) {
+  // Failing to remove the staging directory doesn't affect the import.
+  url_loader_.reset();
+  if (state != IPFS_IMPORT_SUCCESS)
+    return NotifyImportCompleted(state);
+  CreateBraveDirectory();
+}
+
 void IpfsImportWorkerBase::CreateBraveDirectory() {
   DCHECK(!url_loader_);
   GURL url = net::AppendQueryParameter(
@@ -15,12 +15,15 @@
 #include "base/callback.h"
 #include "base/containers/queue.h"
 #include "base/files/file_util.h"
+#include "base/memory/weak_ptr.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/scoped_refptr.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/import/imported_data.h"
+#include "brave/components/ipfs/import/ipfs_folder_import_plan.h"
 #include "brave/components/ipfs/ipfs_network_utils.h"
 #include "components/version_info/channel.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -31,6 +34,11 @@ struct ResourceRequest;
 
 namespace ipfs {
 
+// Reports progress of a folder import as the number of uploaded batches.
+using ImportProgressCallback =
+    base::RepeatingCallback<void(size_t completed_batches,
+                                 size_t total_batches)>;
+
 // A base class that implements steps for importing objects into ipfs.
 // In order to import an object it is necessary to create
 // an ImportWorker of the desired type, each worker can import only one object.
@@ -43,6 +51,12 @@ namespace ipfs {
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
 //   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
 //   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
+// Folders which don't fit into a single add request are uploaded in batches,
+// several at a time. A failed batch is retried without uploading the
+// completed ones again. The folder is then composed from the batches in a
+// staging directory (/api/v0/files/mkdir, /api/v0/files/cp) and its hash
+// is read with /api/v0/files/stat before continuing with step 3. The staging
+// directory is removed (/api/v0/files/rm) whether composing succeeded or not.
 class IpfsImportWorkerBase {
  public:
   IpfsImportWorkerBase(BlobContextGetterFactory* blob_context_getter_factory,
@@ -62,14 +76,41 @@ class IpfsImportWorkerBase {
   void ImportText(const std::string& text, const std::string& host);
   void ImportFolder(const base::FilePath folder_path);
 
+  // Must be called before |ImportFolder|.
+  void SetFolderImportLimits(size_t max_batch_files,
+                             int64_t max_batch_size,
+                             size_t max_parallel_requests);
+  void SetProgressCallback(ImportProgressCallback callback);
+
  protected:
   network::mojom::URLLoaderFactory* GetUrlLoaderFactory();
 
   virtual void NotifyImportCompleted(ipfs::ImportState state);
 
  private:
+  using SimpleURLLoaderList =
+      std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  GURL GetImportAddUrl() const;
   void UploadData(std::unique_ptr<network::ResourceRequest> request);
 
+  void OnFolderImportPlanned(ImportFolderPlan plan);
+  void UploadNextFolderBatches();
+  void UploadFolderBatch(size_t index,
+                         std::unique_ptr<network::ResourceRequest> request);
+  void OnFolderBatchUploaded(SimpleURLLoaderList::iterator iter,
+                             size_t index,
+                             std::unique_ptr<std::string> response_body);
+  void CancelFolderImport();
+  void ComposeFolder();
+  void RunNextComposeRequests();
+  void OnComposeRequestComplete(SimpleURLLoaderList::iterator iter,
+                                std::unique_ptr<std::string> response_body);
+  void OnComposedFolderStat(std::unique_ptr<std::string> response_body);
+  void RemoveStagingDirectory(ipfs::ImportState state);
+  void OnStagingDirectoryRemoved(ipfs::ImportState state,
+                                 std::unique_ptr<std::string> response_body);
+
   void OnImportAddComplete(std::unique_ptr<std::string> response_body);
 
   void CreateBraveDirectory();
@@ -89,6 +130,29 @@ class IpfsImportWorkerBase {
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
   GURL server_endpoint_;
   std::string key_to_publish_;
+
+  // Folder import state.
+  base::FilePath folder_path_;
+  size_t max_batch_files_;
+  int64_t max_batch_size_;
+  size_t max_parallel_requests_;
+  ImportProgressCallback progress_callback_;
+  ImportFolderPlan folder_plan_;
+  // Hash of the imported folder in each uploaded batch, empty until the
+  // batch is uploaded.
+  std::vector<std::string> batch_hashes_;
+  std::vector<int> batch_attempts_;
+  base::queue<size_t> pending_batches_;
+  // Batch requests being created on the IO thread.
+  size_t pending_batch_requests_ = 0;
+  size_t completed_batches_ = 0;
+  std::string staging_directory_;
+  // Requests composing the folder, |absl::nullopt| waits for all previous
+  // requests to complete.
+  base::queue<absl::optional<GURL>> compose_requests_;
+  // Batch uploads and compose requests running in parallel.
+  SimpleURLLoaderList folder_loaders_;
+
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
 };
 
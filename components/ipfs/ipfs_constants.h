@@ -34,6 +34,8 @@ extern const char kGarbageCollectionPath[];
 extern const char kImportAddPath[];
 extern const char kImportMakeDirectoryPath[];
 extern const char kImportCopyPath[];
+extern const char kImportStatPath[];
+extern const char kImportRemovePath[];
 extern const char kImportDirectory[];
 extern const char kAPIPublishNameEndpoint[];
 extern const char kIPFSImportMultipartContentType[];
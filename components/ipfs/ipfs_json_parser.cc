@@ -327,6 +327,36 @@ bool IPFSJSONParser::GetImportResponseFromJSON(const std::string& json,
   return true;
 }
 
+// static
+// Response Format for /api/v0/files/stat
+// {
+//   "Hash":"QmYbK4SLaSvTKKAKvNZMwyzYPy4P3GqBPN6CZzbS73FxxU",
+//   "Size":0,
+//   "CumulativeSize":567857,
+//   "Blocks":2,
+//   "Type":"directory"
+// }
+bool IPFSJSONParser::GetFilesStatFromJSON(const std::string& json,
+                                          ipfs::ImportedData* data) {
+  absl::optional<base::Value> records_v = base::JSONReader::Read(
+      json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!records_v || !records_v->is_dict()) {
+    VLOG(1) << "Invalid response, could not parse JSON, JSON is: " << json;
+    return false;
+  }
+
+  const std::string* hash = records_v->FindStringKey("Hash");
+  if (hash)
+    data->hash = *hash;
+
+  // Large sizes are parsed as doubles.
+  absl::optional<double> size = records_v->FindDoubleKey("CumulativeSize");
+  if (size)
+    data->size = static_cast<int64_t>(*size);
+  return true;
+}
+
 // static
 // Response Format for /api/v0/key/list
 // {"Keys" : [
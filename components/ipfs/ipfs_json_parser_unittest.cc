@@ -166,6 +166,25 @@ TEST_F(IPFSJSONParserTest, GetImportResponseFromJSON) {
   ASSERT_EQ(failed2.size, -1);
 }
 
+TEST_F(IPFSJSONParserTest, GetFilesStatFromJSON) {
+  ipfs::ImportedData success;
+  ASSERT_TRUE(IPFSJSONParser::GetFilesStatFromJSON(R"({
+    "Hash":"QmYbK4SLaSvTKKAKvNZMwyzYPy4P3GqBPN6CZzbS73FxxU",
+    "Size":0,
+    "CumulativeSize":5678570000,
+    "Blocks":2,
+    "Type":"directory"
+    })",
+                                                   &success));
+  EXPECT_EQ(success.hash, "QmYbK4SLaSvTKKAKvNZMwyzYPy4P3GqBPN6CZzbS73FxxU");
+  EXPECT_EQ(success.size, 5678570000);
+
+  ipfs::ImportedData failed;
+  ASSERT_FALSE(IPFSJSONParser::GetFilesStatFromJSON("[]", &failed));
+  EXPECT_EQ(failed.hash, "");
+  EXPECT_EQ(failed.size, -1);
+}
+
 TEST_F(IPFSJSONParserTest, GetParseKeysFromJSON) {
   std::unordered_map<std::string, std::string> parsed_keys;
   std::string response = R"({"Keys" : [)"
@@ -57,15 +57,7 @@ net::NetworkTrafficAnnotationTag GetIpfsNetworkTrafficAnnotationTag() {
 }
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
-struct ImportFileInfo {
-  ImportFileInfo(base::FilePath full_path,
-                 base::FileEnumerator::FileInfo information) {
-    path = full_path;
-    info = information;
-  }
-  base::FilePath path;
-  base::FileEnumerator::FileInfo info;
-};
+using ipfs::ImportFileInfo;
 
 bool GetRelativePathComponent(const base::FilePath& parent,
                               const base::FilePath& child,
@@ -189,6 +181,16 @@ std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(
 }
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
+ImportFileInfo::ImportFileInfo(base::FilePath full_path,
+                               base::FileEnumerator::FileInfo information)
+    : path(full_path), info(information) {}
+
+ImportFileInfo::ImportFileInfo(const ImportFileInfo&) = default;
+
+ImportFileInfo& ImportFileInfo::operator=(const ImportFileInfo&) = default;
+
+ImportFileInfo::~ImportFileInfo() = default;
+
 std::unique_ptr<network::ResourceRequest> CreateResourceRequest(
     BlobBuilderCallback blob_builder_callback,
     const std::string& content_type,
@@ -8,19 +8,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "url/gurl.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
-
 namespace net {
 struct NetworkTrafficAnnotationTag;
 }  // namespace net
@@ -42,6 +40,17 @@ std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(
     std::unique_ptr<network::ResourceRequest> request = nullptr);
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
+struct ImportFileInfo {
+  ImportFileInfo(base::FilePath full_path,
+                 base::FileEnumerator::FileInfo information);
+  ImportFileInfo(const ImportFileInfo&);
+  ImportFileInfo& operator=(const ImportFileInfo&);
+  ~ImportFileInfo();
+
+  base::FilePath path;
+  base::FileEnumerator::FileInfo info;
+};
+
 void AddMultipartHeaderForUploadWithFileName(const std::string& value_name,
                                              const std::string& file_name,
                                              const std::string& absolute_path,
@@ -69,6 +78,16 @@ void CreateRequestForFolder(const base::FilePath& folder_path,
                             BlobContextGetterFactory* context_getter_factory,
                             ResourceRequestGetter request_callback);
 
+// Creates a request uploading |files| of |folder_path|, named relative to the
+// parent of |folder_path|.
+void CreateRequestForFileList(ResourceRequestGetter request_callback,
+                              BlobContextGetterFactory* context_getter_factory,
+                              const base::FilePath& folder_path,
+                              std::vector<ImportFileInfo> files);
+
+// Returns all files and directories under |dir_path|, skipping symlinks.
+std::vector<ImportFileInfo> EnumerateDirectoryFiles(base::FilePath dir_path);
+
 void CreateRequestForText(const std::string& text,
                           const std::string& filename,
                           BlobContextGetterFactory* blob_context_getter_factory,
@@ -37,7 +37,7 @@
 #include "brave/vendor/brave_base/random.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
-#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "third_party/metrics_proto/reporting_info.pb.h"
 
@@ -316,6 +316,7 @@ void BraveP3AService::StartScheduledUpload() {
 void BraveP3AService::OnHistogramChanged(const char* histogram_name,
                                          uint64_t name_hash,
                                          base::HistogramBase::Sample sample) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   std::unique_ptr<base::HistogramSamples> samples =
       base::StatisticsRecorder::FindHistogram(histogram_name)->SnapshotDelta();
 
@@ -326,10 +327,8 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
-    content::GetUIThreadTaskRunner({})->PostTask(
-        FROM_HERE, base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this, histogram_name, kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+    OnHistogramChangedOnUI(histogram_name, kSuspendedMetricValue,
+                           kSuspendedMetricBucket);
     return;
   }
 
@@ -358,9 +357,7 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
   }
 
-  content::GetUIThreadTaskRunner({})->PostTask(
-      FROM_HERE, base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  OnHistogramChangedOnUI(histogram_name, sample, bucket);
 }
 
 void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
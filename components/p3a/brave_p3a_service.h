@@ -77,8 +77,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   void StartScheduledUpload();
 
-  // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // Invoked by callbacks registered by our service. StatisticsRecorder runs
+  // them on the sequence which registered them, which is UI thread.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
@@ -7,7 +7,11 @@
 
 #include <utility>
 
+#include "base/bind.h"
+#include "base/callback_helpers.h"
+#include "base/json/values_util.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
 
@@ -20,6 +24,28 @@ BatAdsClientMojoBridge::BatAdsClientMojoBridge(
 
 BatAdsClientMojoBridge::~BatAdsClientMojoBridge() = default;
 
+void BatAdsClientMojoBridge::SetMirroredPrefs(
+    std::vector<mojom::MirroredPrefPtr> prefs) {
+  for (auto& pref : prefs) {
+    // The browser has not seen all of our writes yet, so the value it sent
+    // may be older than the mirrored one.
+    if (pending_pref_writes_.contains(pref->path)) {
+      continue;
+    }
+
+    mirrored_prefs_[pref->path] = {std::move(pref->value),
+                                   pref->has_pref_path};
+  }
+}
+
+void BatAdsClientMojoBridge::OnAdEventsChanged() {
+  ad_events_.clear();
+}
+
+void BatAdsClientMojoBridge::SetBrowserIsActive(const bool is_browser_active) {
+  is_browser_active_ = is_browser_active;
+}
+
 bool BatAdsClientMojoBridge::CanShowBackgroundNotifications() const {
   if (!connected())
     return false;
@@ -44,9 +70,13 @@ bool BatAdsClientMojoBridge::IsBrowserActive() const {
     return false;
   }
 
-  bool is_browser_active;
-  bat_ads_client_->IsBrowserActive(&is_browser_active);
-  return is_browser_active;
+  if (!is_browser_active_) {
+    bool is_browser_active;
+    bat_ads_client_->IsBrowserActive(&is_browser_active);
+    is_browser_active_ = is_browser_active;
+  }
+
+  return *is_browser_active_;
 }
 
 bool BatAdsClientMojoBridge::IsBrowserInFullScreenMode() const {
@@ -96,6 +126,8 @@ void BatAdsClientMojoBridge::RecordAdEventForId(
     return;
   }
 
+  // The browser purges old ad events when recording, so read them again.
+  ad_events_.erase({ad_type, confirmation_type});
   bat_ads_client_->RecordAdEventForId(id, ad_type, confirmation_type, time);
 }
 
@@ -106,8 +138,15 @@ std::vector<base::Time> BatAdsClientMojoBridge::GetAdEvents(
     return {};
   }
 
+  const auto key = std::make_pair(ad_type, confirmation_type);
+  const auto iter = ad_events_.find(key);
+  if (iter != ad_events_.end()) {
+    return iter->second;
+  }
+
   std::vector<base::Time> ad_event_history;
   bat_ads_client_->GetAdEvents(ad_type, confirmation_type, &ad_event_history);
+  ad_events_[key] = ad_event_history;
   return ad_event_history;
 }
 
@@ -116,6 +155,7 @@ void BatAdsClientMojoBridge::ResetAdEventsForId(const std::string& id) const {
     return;
   }
 
+  ad_events_.clear();
   bat_ads_client_->ResetAdEventsForId(id);
 }
 
@@ -308,6 +348,10 @@ bool BatAdsClientMojoBridge::GetBooleanPref(
     const std::string& path) const {
   bool value = false;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    return mirrored_value->GetIfBool().value_or(value);
+  }
+
   if (!connected()) {
     return value;
   }
@@ -323,13 +367,19 @@ void BatAdsClientMojoBridge::SetBooleanPref(
     return;
   }
 
-  bat_ads_client_->SetBooleanPref(path, value);
+  const bool is_mirrored = SetMirroredPrefValue(path, base::Value(value));
+  bat_ads_client_->SetBooleanPref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 int BatAdsClientMojoBridge::GetIntegerPref(
     const std::string& path) const {
   int value = 0;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    return mirrored_value->GetIfInt().value_or(value);
+  }
+
   if (!connected()) {
     return value;
   }
@@ -345,13 +395,19 @@ void BatAdsClientMojoBridge::SetIntegerPref(
     return;
   }
 
-  bat_ads_client_->SetIntegerPref(path, value);
+  const bool is_mirrored = SetMirroredPrefValue(path, base::Value(value));
+  bat_ads_client_->SetIntegerPref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 double BatAdsClientMojoBridge::GetDoublePref(
     const std::string& path) const {
   double value = 0.0;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    return mirrored_value->GetIfDouble().value_or(value);
+  }
+
   if (!connected()) {
     return value;
   }
@@ -367,13 +423,22 @@ void BatAdsClientMojoBridge::SetDoublePref(
     return;
   }
 
-  bat_ads_client_->SetDoublePref(path, value);
+  const bool is_mirrored = SetMirroredPrefValue(path, base::Value(value));
+  bat_ads_client_->SetDoublePref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 std::string BatAdsClientMojoBridge::GetStringPref(
     const std::string& path) const {
   std::string value;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    if (const std::string* mirrored_string = mirrored_value->GetIfString()) {
+      return *mirrored_string;
+    }
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
@@ -389,13 +454,23 @@ void BatAdsClientMojoBridge::SetStringPref(
     return;
   }
 
-  bat_ads_client_->SetStringPref(path, value);
+  const bool is_mirrored = SetMirroredPrefValue(path, base::Value(value));
+  bat_ads_client_->SetStringPref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 int64_t BatAdsClientMojoBridge::GetInt64Pref(
     const std::string& path) const {
   int64_t value = 0;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    // Prefs store 64-bit integers as strings.
+    if (mirrored_value->is_string()) {
+      base::StringToInt64(mirrored_value->GetString(), &value);
+    }
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
@@ -411,13 +486,23 @@ void BatAdsClientMojoBridge::SetInt64Pref(
     return;
   }
 
-  bat_ads_client_->SetInt64Pref(path, value);
+  const bool is_mirrored =
+      SetMirroredPrefValue(path, base::Value(base::NumberToString(value)));
+  bat_ads_client_->SetInt64Pref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 uint64_t BatAdsClientMojoBridge::GetUint64Pref(
     const std::string& path) const {
   uint64_t value = 0;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    if (mirrored_value->is_string()) {
+      base::StringToUint64(mirrored_value->GetString(), &value);
+    }
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
@@ -433,12 +518,19 @@ void BatAdsClientMojoBridge::SetUint64Pref(
     return;
   }
 
-  bat_ads_client_->SetUint64Pref(path, value);
+  const bool is_mirrored =
+      SetMirroredPrefValue(path, base::Value(base::NumberToString(value)));
+  bat_ads_client_->SetUint64Pref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 base::Time BatAdsClientMojoBridge::GetTimePref(const std::string& path) const {
   base::Time value;
 
+  if (const base::Value* mirrored_value = GetMirroredPrefValue(path)) {
+    return base::ValueToTime(*mirrored_value).value_or(value);
+  }
+
   if (!connected()) {
     return value;
   }
@@ -453,7 +545,9 @@ void BatAdsClientMojoBridge::SetTimePref(const std::string& path,
     return;
   }
 
-  bat_ads_client_->SetTimePref(path, value);
+  const bool is_mirrored = SetMirroredPrefValue(path, base::TimeToValue(value));
+  bat_ads_client_->SetTimePref(
+      path, value, GetPrefWrittenCallback(path, is_mirrored));
 }
 
 void BatAdsClientMojoBridge::ClearPref(
@@ -462,12 +556,20 @@ void BatAdsClientMojoBridge::ClearPref(
     return;
   }
 
+  // The browser knows the default value, so read it from there until the
+  // cleared pref is pushed again.
+  mirrored_prefs_.erase(path);
   bat_ads_client_->ClearPref(path);
 }
 
 bool BatAdsClientMojoBridge::HasPrefPath(const std::string& path) const {
   bool value = false;
 
+  const auto iter = mirrored_prefs_.find(path);
+  if (iter != mirrored_prefs_.end()) {
+    return iter->second.has_pref_path;
+  }
+
   if (!connected()) {
     return value;
   }
@@ -482,4 +584,46 @@ bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+const base::Value* BatAdsClientMojoBridge::GetMirroredPrefValue(
+    const std::string& path) const {
+  const auto iter = mirrored_prefs_.find(path);
+  if (iter == mirrored_prefs_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second.value;
+}
+
+bool BatAdsClientMojoBridge::SetMirroredPrefValue(const std::string& path,
+                                                  base::Value value) {
+  const auto iter = mirrored_prefs_.find(path);
+  if (iter == mirrored_prefs_.end()) {
+    return false;
+  }
+
+  iter->second.value = std::move(value);
+  iter->second.has_pref_path = true;
+  return true;
+}
+
+base::OnceClosure BatAdsClientMojoBridge::GetPrefWrittenCallback(
+    const std::string& path,
+    const bool is_mirrored) {
+  if (!is_mirrored) {
+    return base::DoNothing();
+  }
+
+  pending_pref_writes_[path]++;
+  return base::BindOnce(&BatAdsClientMojoBridge::OnPrefWritten,
+                        weak_ptr_factory_.GetWeakPtr(), path);
+}
+
+void BatAdsClientMojoBridge::OnPrefWritten(const std::string& path) {
+  const auto iter = pending_pref_writes_.find(path);
+  DCHECK(iter != pending_pref_writes_.end());
+  if (--iter->second == 0) {
+    pending_pref_writes_.erase(iter);
+  }
+}
+
 }  // namespace bat_ads
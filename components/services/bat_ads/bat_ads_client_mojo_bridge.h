@@ -8,13 +8,19 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ads/ads_client.h"
 #include "bat/ads/notification_ad_info.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace base {
 class Time;
@@ -33,6 +39,17 @@ class BatAdsClientMojoBridge
   BatAdsClientMojoBridge(const BatAdsClientMojoBridge&) = delete;
   BatAdsClientMojoBridge& operator=(const BatAdsClientMojoBridge&) = delete;
 
+  // Prefs pushed by the browser are read locally instead of with a sync call.
+  // Values of the prefs which are being written by the ads library are kept
+  // until the browser has acknowledged all of the writes.
+  void SetMirroredPrefs(std::vector<mojom::MirroredPrefPtr> prefs);
+
+  // Drops the ad events read from the browser, i.e. when another ads instance
+  // recorded or reset ad events.
+  void OnAdEventsChanged();
+
+  void SetBrowserIsActive(const bool is_browser_active);
+
   // AdsClient implementation
   bool CanShowBackgroundNotifications() const override;
 
@@ -121,9 +138,35 @@ class BatAdsClientMojoBridge
   bool HasPrefPath(const std::string& path) const override;
 
  private:
+  struct MirroredPref {
+    base::Value value;
+    bool has_pref_path = false;
+  };
+
   bool connected() const;
 
+  // Returns nullptr if |path| is not mirrored.
+  const base::Value* GetMirroredPrefValue(const std::string& path) const;
+  // Updates the mirrored value of |path| ahead of the browser, returns false
+  // if |path| is not mirrored.
+  bool SetMirroredPrefValue(const std::string& path, base::Value value);
+  base::OnceClosure GetPrefWrittenCallback(const std::string& path,
+                                           const bool is_mirrored);
+  void OnPrefWritten(const std::string& path);
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  base::flat_map<std::string, MirroredPref> mirrored_prefs_;
+  // Pref path -> number of writes not yet acknowledged by the browser.
+  base::flat_map<std::string, int> pending_pref_writes_;
+
+  mutable absl::optional<bool> is_browser_active_;
+  // Ad type and confirmation type -> ad events.
+  mutable base::flat_map<std::pair<std::string, std::string>,
+                         std::vector<base::Time>>
+      ad_events_;
+
+  base::WeakPtrFactory<BatAdsClientMojoBridge> weak_ptr_factory_{this};
 };
 
 }  // namespace bat_ads
@@ -69,6 +69,14 @@ void BatAdsImpl::OnPrefChanged(const std::string& path) {
   ads_->OnPrefChanged(path);
 }
 
+void BatAdsImpl::SetMirroredPrefs(std::vector<mojom::MirroredPrefPtr> prefs) {
+  bat_ads_client_mojo_proxy_->SetMirroredPrefs(std::move(prefs));
+}
+
+void BatAdsImpl::OnAdEventsChanged() {
+  bat_ads_client_mojo_proxy_->OnAdEventsChanged();
+}
+
 void BatAdsImpl::OnHtmlLoaded(const int32_t tab_id,
                               const std::vector<GURL>& redirect_chain,
                               const std::string& html) {
@@ -94,10 +102,12 @@ void BatAdsImpl::OnIdle() {
 }
 
 void BatAdsImpl::OnBrowserDidEnterForeground() {
+  bat_ads_client_mojo_proxy_->SetBrowserIsActive(true);
   ads_->OnBrowserDidEnterForeground();
 }
 
 void BatAdsImpl::OnBrowserDidEnterBackground() {
+  bat_ads_client_mojo_proxy_->SetBrowserIsActive(false);
   ads_->OnBrowserDidEnterBackground();
 }
 
@@ -47,6 +47,8 @@ class BatAdsImpl :
       const std::string& locale) override;
 
   void OnPrefChanged(const std::string& path) override;
+  void SetMirroredPrefs(std::vector<mojom::MirroredPrefPtr> prefs) override;
+  void OnAdEventsChanged() override;
 
   void OnHtmlLoaded(const int32_t tab_id,
                     const std::vector<GURL>& redirect_chain,
@@ -309,8 +309,10 @@ void AdsClientMojoBridge::GetBooleanPref(
 
 void AdsClientMojoBridge::SetBooleanPref(
     const std::string& path,
-    const bool value) {
+    const bool value,
+    SetBooleanPrefCallback callback) {
   ads_client_->SetBooleanPref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetIntegerPref(
@@ -321,8 +323,10 @@ void AdsClientMojoBridge::GetIntegerPref(
 
 void AdsClientMojoBridge::SetIntegerPref(
     const std::string& path,
-    const int value) {
+    const int value,
+    SetIntegerPrefCallback callback) {
   ads_client_->SetIntegerPref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetDoublePref(
@@ -333,8 +337,10 @@ void AdsClientMojoBridge::GetDoublePref(
 
 void AdsClientMojoBridge::SetDoublePref(
     const std::string& path,
-    const double value) {
+    const double value,
+    SetDoublePrefCallback callback) {
   ads_client_->SetDoublePref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetStringPref(
@@ -345,8 +351,10 @@ void AdsClientMojoBridge::GetStringPref(
 
 void AdsClientMojoBridge::SetStringPref(
     const std::string& path,
-    const std::string& value) {
+    const std::string& value,
+    SetStringPrefCallback callback) {
   ads_client_->SetStringPref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetInt64Pref(
@@ -357,8 +365,10 @@ void AdsClientMojoBridge::GetInt64Pref(
 
 void AdsClientMojoBridge::SetInt64Pref(
     const std::string& path,
-    const int64_t value) {
+    const int64_t value,
+    SetInt64PrefCallback callback) {
   ads_client_->SetInt64Pref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetUint64Pref(
@@ -369,8 +379,10 @@ void AdsClientMojoBridge::GetUint64Pref(
 
 void AdsClientMojoBridge::SetUint64Pref(
     const std::string& path,
-    const uint64_t value) {
+    const uint64_t value,
+    SetUint64PrefCallback callback) {
   ads_client_->SetUint64Pref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetTimePref(const std::string& path,
@@ -379,8 +391,10 @@ void AdsClientMojoBridge::GetTimePref(const std::string& path,
 }
 
 void AdsClientMojoBridge::SetTimePref(const std::string& path,
-                                      const base::Time value) {
+                                      const base::Time value,
+                                      SetTimePrefCallback callback) {
   ads_client_->SetTimePref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::ClearPref(
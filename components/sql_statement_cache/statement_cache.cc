@@ -0,0 +1,69 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/sql_statement_cache/statement_cache.h"
+
+#include <utility>
+
+#include "base/check.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+
+namespace sql_statement_cache {
+
+namespace {
+
+constexpr size_t kMaxCachedStatements = 64;
+constexpr size_t kMaxSeenQueries = 64;
+
+}  // namespace
+
+StatementCache::StatementCache(sql::Database* db)
+    : db_(db),
+      statements_(kMaxCachedStatements),
+      seen_queries_(kMaxSeenQueries) {
+  DCHECK(db_);
+}
+
+StatementCache::~StatementCache() = default;
+
+sql::Statement* StatementCache::GetStatement(
+    const std::string& query,
+    sql::Statement* uncached_statement) {
+  DCHECK(uncached_statement);
+
+  const auto iter = statements_.Get(query);
+  if (iter != statements_.end()) {
+    // Cached statements are invalidated if the database is closed or poisoned
+    if (iter->second->is_valid()) {
+      return iter->second.get();
+    }
+
+    statements_.Erase(iter);
+  }
+
+  const auto seen_iter = seen_queries_.Peek(query);
+  if (seen_iter == seen_queries_.end()) {
+    seen_queries_.Put(query, true);
+    uncached_statement->Assign(db_->GetUniqueStatement(query.c_str()));
+    return uncached_statement->is_valid() ? uncached_statement : nullptr;
+  }
+  seen_queries_.Erase(seen_iter);
+
+  auto statement =
+      std::make_unique<sql::Statement>(db_->GetUniqueStatement(query.c_str()));
+  if (!statement->is_valid()) {
+    return nullptr;
+  }
+
+  return statements_.Put(query, std::move(statement))->second.get();
+}
+
+void StatementCache::Clear() {
+  statements_.Clear();
+  seen_queries_.Clear();
+}
+
+}  // namespace sql_statement_cache
@@ -0,0 +1,59 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SQL_STATEMENT_CACHE_STATEMENT_CACHE_H_
+#define BRAVE_COMPONENTS_SQL_STATEMENT_CACHE_STATEMENT_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/raw_ptr.h"
+
+namespace sql {
+class Database;
+class Statement;
+}  // namespace sql
+
+namespace sql_statement_cache {
+
+// Keeps prepared statements keyed by SQL text, so that commands which are run
+// repeatedly are not re-prepared by SQLite for every transaction.
+//
+// Queries which inline their values are rarely run twice, so a statement is
+// only cached the second time its query is seen. Otherwise these queries would
+// evict the statements which are actually reused.
+class StatementCache {
+ public:
+  // |db| must outlive this object.
+  explicit StatementCache(sql::Database* db);
+  ~StatementCache();
+
+  StatementCache(const StatementCache&) = delete;
+  StatementCache& operator=(const StatementCache&) = delete;
+
+  // Returns a cached statement for |query|, or prepares a one-off statement in
+  // |uncached_statement| if |query| was not seen recently. Returns nullptr if
+  // the statement is invalid.
+  sql::Statement* GetStatement(const std::string& query,
+                               sql::Statement* uncached_statement);
+
+  // Drops all statements, e.g. before the database is closed or on memory
+  // pressure.
+  void Clear();
+
+  size_t size() const { return statements_.size(); }
+
+ private:
+  const raw_ptr<sql::Database> db_;
+
+  base::LRUCache<std::string, std::unique_ptr<sql::Statement>> statements_;
+  // Queries run once and not cached yet.
+  base::HashingLRUCache<std::string, bool> seen_queries_;
+};
+
+}  // namespace sql_statement_cache
+
+#endif  // BRAVE_COMPONENTS_SQL_STATEMENT_CACHE_STATEMENT_CACHE_H_
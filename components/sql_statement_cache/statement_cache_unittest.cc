@@ -0,0 +1,87 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/sql_statement_cache/statement_cache.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace sql_statement_cache {
+
+namespace {
+
+constexpr char kInsertQuery[] = "INSERT INTO test (a) VALUES (?)";
+
+}  // namespace
+
+class StatementCacheTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(db_.OpenInMemory());
+    ASSERT_TRUE(db_.Execute("CREATE TABLE test (a INTEGER)"));
+  }
+
+ protected:
+  sql::Database db_;
+  StatementCache cache_{&db_};
+};
+
+TEST_F(StatementCacheTest, CacheStatementWhenQueryIsSeenAgain) {
+  sql::Statement uncached_statement;
+  EXPECT_EQ(&uncached_statement,
+            cache_.GetStatement(kInsertQuery, &uncached_statement));
+  EXPECT_TRUE(uncached_statement.is_valid());
+  EXPECT_EQ(0u, cache_.size());
+
+  sql::Statement unused_statement;
+  sql::Statement* statement =
+      cache_.GetStatement(kInsertQuery, &unused_statement);
+  ASSERT_TRUE(statement);
+  EXPECT_NE(&unused_statement, statement);
+  EXPECT_FALSE(unused_statement.is_valid());
+  EXPECT_EQ(1u, cache_.size());
+
+  EXPECT_EQ(statement, cache_.GetStatement(kInsertQuery, &unused_statement));
+  EXPECT_EQ(1u, cache_.size());
+}
+
+TEST_F(StatementCacheTest, DoNotEvictReusedStatementsForOneOffQueries) {
+  sql::Statement unused_statement;
+  cache_.GetStatement(kInsertQuery, &unused_statement);
+  sql::Statement* statement =
+      cache_.GetStatement(kInsertQuery, &unused_statement);
+  ASSERT_TRUE(statement);
+
+  for (int i = 0; i < 100; i++) {
+    sql::Statement uncached_statement;
+    EXPECT_EQ(&uncached_statement,
+              cache_.GetStatement("SELECT " + base::NumberToString(i),
+                                  &uncached_statement));
+  }
+
+  EXPECT_EQ(1u, cache_.size());
+  EXPECT_EQ(statement, cache_.GetStatement(kInsertQuery, &unused_statement));
+}
+
+TEST_F(StatementCacheTest, ForgetStatementsAndSeenQueriesOnClear) {
+  sql::Statement unused_statement;
+  cache_.GetStatement(kInsertQuery, &unused_statement);
+  cache_.GetStatement(kInsertQuery, &unused_statement);
+  ASSERT_EQ(1u, cache_.size());
+
+  cache_.Clear();
+  EXPECT_EQ(0u, cache_.size());
+
+  sql::Statement uncached_statement;
+  EXPECT_EQ(&uncached_statement,
+            cache_.GetStatement(kInsertQuery, &uncached_statement));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+}  // namespace sql_statement_cache
@@ -5,7 +5,6 @@
 
 #include "brave/components/time_period_storage/daily_storage.h"
 
-#include <numeric>
 #include <utility>
 
 #include "base/logging.h"
@@ -16,6 +15,17 @@
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
 
+namespace {
+
+base::Value ToPrefValue(base::Time time, uint64_t value) {
+  base::Value dict(base::Value::Type::DICTIONARY);
+  dict.SetKey("day", base::Value(time.ToDoubleT()));
+  dict.SetDoubleKey("value", value);
+  return dict;
+}
+
+}  // namespace
+
 DailyStorage::DailyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
       pref_name_(pref_name),
@@ -39,24 +49,23 @@ DailyStorage::~DailyStorage() = default;
 
 void DailyStorage::RecordValueNow(uint64_t delta) {
   daily_values_.push_front({clock_->Now(), delta});
+  values_sum_ += delta;
+  FilterToDay();
   Save();
 }
 
 uint64_t DailyStorage::GetLast24HourSum() const {
-  // We record only value for last N days.
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [](const uint64_t acc, const DailyValue& item) {
-                           return acc + item.value;
-                         });
+  return values_sum_;
 }
 
 void DailyStorage::FilterToDay() {
-  if (daily_values_.empty()) {
-    return;
-  }
-  // Remove all values that aren't within the last 24 hours
+  // Remove all values that aren't within the last 24 hours. Values are kept
+  // most recent first, so these are at the back.
   base::Time min = clock_->Now() - base::Days(1);
-  daily_values_.remove_if([min](DailyValue val) { return (val.time <= min); });
+  while (!daily_values_.empty() && daily_values_.back().time <= min) {
+    values_sum_ -= daily_values_.back().value;
+    daily_values_.pop_back();
+  }
 }
 
 void DailyStorage::Load() {
@@ -71,26 +80,37 @@ void DailyStorage::Load() {
     const base::Value* value = it.FindKey("value");
     // Validate correct data format
     if (!day || !value || !day->is_double() || !value->is_double()) {
+      pref_mirrors_values_ = false;
       continue;
     }
     // Disregard if old value
     auto time = base::Time::FromDoubleT(day->GetDouble());
     if (time <= min) {
+      pref_mirrors_values_ = false;
       continue;
     }
     daily_values_.push_back({time, static_cast<uint64_t>(value->GetDouble())});
+    values_sum_ += daily_values_.back().value;
   }
 }
 
 void DailyStorage::Save() {
-  FilterToDay();
+  DCHECK(!daily_values_.empty());
   ListPrefUpdate update(prefs_, pref_name_);
   base::Value* list = update.Get();
-  list->ClearList();
-  for (const auto& u : daily_values_) {
-    base::DictionaryValue value;
-    value.SetKey("day", base::Value(u.time.ToDoubleT()));
-    value.SetDoubleKey("value", u.value);
-    list->Append(std::move(value));
+  if (!pref_mirrors_values_ || list->GetList().size() + 1 < daily_values_.size()) {
+    list->ClearList();
+    for (const auto& u : daily_values_) {
+      list->Append(ToPrefValue(u.time, u.value));
+    }
+    pref_mirrors_values_ = true;
+    return;
+  }
+  // Since the last save only the most recent value was added and values at
+  // the back have expired.
+  const DailyValue& latest = daily_values_.front();
+  list->Insert(list->GetList().begin(), ToPrefValue(latest.time, latest.value));
+  while (list->GetList().size() > daily_values_.size()) {
+    list->EraseListIter(list->GetList().end() - 1);
   }
 }
@@ -6,9 +6,9 @@
 #ifndef BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_DAILY_STORAGE_H_
 #define BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_DAILY_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -44,13 +44,19 @@ class DailyStorage {
   };
   void FilterToDay();
   void Load();
+  // Updates the pref list in place, unless it does not mirror
+  // |daily_values_| yet.
   void Save();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Most recent value first.
+  base::circular_deque<DailyValue> daily_values_;
+  uint64_t values_sum_ = 0ull;
+  // False when Load() skipped entries of the pref list.
+  bool pref_mirrors_values_ = true;
 };
 
 #endif  // BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_DAILY_STORAGE_H_
@@ -15,10 +15,11 @@
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+constexpr char kPrefName[] = "brave.daily_test";
+
 class DailyStorageTest : public ::testing::Test {
  public:
   DailyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.daily_test";
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<DailyStorage>(
@@ -97,3 +98,25 @@ TEST_F(DailyStorageTest, InfrequentUsage) {
   state_->RecordValueNow(value);
   EXPECT_EQ(state_->GetLast24HourSum(), 2 * value);
 }
+
+TEST_F(DailyStorageTest, PersistsValuesAcrossRestart) {
+  uint64_t value = 10000;
+  state_->RecordValueNow(value);
+  clock_->Advance(base::Hours(12));
+  state_->RecordValueNow(value);
+  clock_->Advance(base::Hours(13));
+  state_->RecordValueNow(value);
+  EXPECT_EQ(state_->GetLast24HourSum(), 2 * value);
+  // The expired value is dropped from the pref as well.
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 2u);
+
+  const base::Time now = clock_->Now();
+  clock_ = new base::SimpleTestClock;
+  clock_->SetNow(now);
+  state_ = std::make_unique<DailyStorage>(
+      &pref_service_, kPrefName, std::unique_ptr<base::Clock>(clock_));
+  EXPECT_EQ(state_->GetLast24HourSum(), 2 * value);
+  state_->RecordValueNow(value);
+  EXPECT_EQ(state_->GetLast24HourSum(), 3 * value);
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 3u);
+}
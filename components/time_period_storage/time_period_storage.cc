@@ -6,7 +6,6 @@
 #include "brave/components/time_period_storage/time_period_storage.h"
 
 #include <algorithm>
-#include <numeric>
 #include <utility>
 
 #include "base/time/clock.h"
@@ -44,67 +43,101 @@ TimePeriodStorage::TimePeriodStorage(PrefService* prefs,
 TimePeriodStorage::~TimePeriodStorage() = default;
 
 void TimePeriodStorage::AddDelta(uint64_t delta) {
-  FilterToPeriod();
-  daily_values_.front().value += delta;
-  Save();
+  const bool day_changed = FilterToPeriod();
+  if (delta == 0 && !day_changed) {
+    return;
+  }
+  DailyValue& today = daily_values_.front();
+  today.value += delta;
+  values_sum_ += delta;
+  if (highest_value_) {
+    highest_value_ = std::max(*highest_value_, today.value);
+  }
+  if (day_changed) {
+    SaveAll();
+  } else {
+    Save();
+  }
 }
 
 void TimePeriodStorage::SubDelta(uint64_t delta) {
-  FilterToPeriod();
-  for (DailyValue& daily_value : daily_values_) {
+  const bool day_changed = FilterToPeriod();
+  if (delta == 0 && !day_changed) {
+    return;
+  }
+  bool only_today_changed = true;
+  for (auto it = daily_values_.begin(); it != daily_values_.end(); ++it) {
     if (delta == 0) {
       break;
     }
-    uint64_t day_delta = std::min(daily_value.value, delta);
-    daily_value.value -= day_delta;
+    uint64_t day_delta = std::min(it->value, delta);
+    if (day_delta != 0 && it != daily_values_.begin()) {
+      only_today_changed = false;
+    }
+    it->value -= day_delta;
+    values_sum_ -= day_delta;
     delta -= day_delta;
+    if (day_delta != 0) {
+      highest_value_.reset();
+    }
+  }
+  if (day_changed || !only_today_changed) {
+    SaveAll();
+  } else {
+    Save();
   }
-  Save();
 }
 
 void TimePeriodStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
-  FilterToPeriod();
+  const bool day_changed = FilterToPeriod();
   DailyValue& today = daily_values_.front();
+  if (today.value >= value && !day_changed) {
+    return;
+  }
   if (today.value < value) {
+    values_sum_ += value - today.value;
     today.value = value;
+    if (highest_value_) {
+      highest_value_ = std::max(*highest_value_, value);
+    }
+  }
+  if (day_changed) {
+    SaveAll();
+  } else {
+    Save();
   }
-  Save();
 }
 
 uint64_t TimePeriodStorage::GetPeriodSum() const {
-  // We record only value for last N days.
+  // We record only value for last N days. Days which left the period since
+  // the last update are still stored at the back.
   const base::Time n_days_ago = clock_->Now() - base::Days(period_days_);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  uint64_t sum = values_sum_;
+  for (auto it = daily_values_.rbegin();
+       it != daily_values_.rend() && it->day <= n_days_ago; ++it) {
+    sum -= it->value;
+  }
+  return sum;
 }
 
 uint64_t TimePeriodStorage::GetHighestValueInPeriod() const {
   // We record only value for last N days.
   const base::Time n_days_ago = clock_->Now() - base::Days(period_days_);
-  std::list<DailyValue> in_period_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   in_period_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  in_period_daily_values.resize(
-      std::distance(in_period_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(in_period_daily_values.begin(),
-                                     in_period_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == in_period_daily_values.end()) {
-    return 0;
-  }
-  return highest_it->value;
+  const bool has_expired_days =
+      !daily_values_.empty() && daily_values_.back().day <= n_days_ago;
+  if (highest_value_ && !has_expired_days) {
+    return *highest_value_;
+  }
+  uint64_t highest_value = 0;
+  for (const auto& daily_value : daily_values_) {
+    if (daily_value.day > n_days_ago) {
+      highest_value = std::max(highest_value, daily_value.value);
+    }
+  }
+  if (!has_expired_days) {
+    highest_value_ = highest_value;
+  }
+  return highest_value;
 }
 
 bool TimePeriodStorage::IsOnePeriodPassed() const {
@@ -113,7 +146,7 @@ bool TimePeriodStorage::IsOnePeriodPassed() const {
   return daily_values_.size() == period_days_;
 }
 
-void TimePeriodStorage::FilterToPeriod() {
+bool TimePeriodStorage::FilterToPeriod() {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
 
@@ -126,9 +159,13 @@ void TimePeriodStorage::FilterToPeriod() {
     // save it with a new timestamp.
     daily_values_.push_front({now_midnight, 0});
     if (daily_values_.size() > period_days_) {
+      values_sum_ -= daily_values_.back().value;
       daily_values_.pop_back();
+      highest_value_.reset();
     }
+    return true;
   }
+  return false;
 }
 
 void TimePeriodStorage::Load() {
@@ -148,16 +185,37 @@ void TimePeriodStorage::Load() {
     }
     daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
                              static_cast<uint64_t>(value->GetDouble())});
+    values_sum_ += daily_values_.back().value;
   }
 }
 
 void TimePeriodStorage::Save() {
   DCHECK(!daily_values_.empty());
+
+  const base::Value* current_list = prefs_->GetList(pref_name_);
+  if (!current_list || current_list->GetList().size() != daily_values_.size()) {
+    SaveAll();
+    return;
+  }
+
+  const DailyValue& today = daily_values_.front();
+  const absl::optional<double> current_day =
+      current_list->GetList()[0].FindDoubleKey("day");
+  if (!current_day || *current_day != today.day.ToDoubleT()) {
+    SaveAll();
+    return;
+  }
+
+  ListPrefUpdate update(prefs_, pref_name_);
+  update.Get()->GetList()[0].SetDoubleKey("value", today.value);
+}
+
+void TimePeriodStorage::SaveAll() {
+  DCHECK(!daily_values_.empty());
   DCHECK_LE(daily_values_.size(), period_days_);
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::Value* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->ClearList();
   for (const auto& u : daily_values_) {
     base::DictionaryValue value;
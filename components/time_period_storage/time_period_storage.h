@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_TIME_PERIOD_STORAGE_H_
 #define BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_TIME_PERIOD_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
 #include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace base {
 class Clock;
@@ -48,16 +49,27 @@ class TimePeriodStorage {
     base::Time day;
     uint64_t value = 0ull;
   };
-  void FilterToPeriod();
+  // Returns true if a new day was started.
+  bool FilterToPeriod();
   void Load();
+  // Updates today's value in place when the pref already mirrors
+  // |daily_values_| apart from today's value, otherwise rewrites the list.
   void Save();
+  void SaveAll();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   size_t period_days_;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Ring buffer of at most |period_days_| values, most recent day first.
+  base::circular_deque<DailyValue> daily_values_;
+  // Sum of all |daily_values_|, including days which left the period since
+  // the last update.
+  uint64_t values_sum_ = 0ull;
+  // Highest of |daily_values_|, recomputed on demand after a value decreased
+  // or a day was dropped.
+  mutable absl::optional<uint64_t> highest_value_;
 };
 
 #endif  // BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_TIME_PERIOD_STORAGE_H_
@@ -214,3 +214,50 @@ TEST_F(TimePeriodStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetPeriodSum(), high_value + low_value);
 }
+
+TEST_F(TimePeriodStorageTest, PersistsInPlaceUpdatesAcrossRestart) {
+  InitStorage(7);
+  state_->AddDelta(1000);
+  clock_->Advance(base::Days(1));
+  state_->AddDelta(2000);
+  state_->AddDelta(3000);
+  state_->ReplaceTodaysValueIfGreater(4000);
+  state_->SubDelta(500);
+  EXPECT_EQ(state_->GetPeriodSum(), 5500U);
+
+  const base::Time now = clock_->Now();
+  clock_ = new base::SimpleTestClock;
+  clock_->SetNow(now);
+  InitStorage(7);
+  EXPECT_EQ(state_->GetPeriodSum(), 5500U);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 4500U);
+}
+
+TEST_F(TimePeriodStorageTest, UpdatesHighestValueAfterDecreaseAndExpiry) {
+  InitStorage(3);
+  state_->AddDelta(100);
+  clock_->Advance(base::Days(1));
+  state_->AddDelta(300);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 300U);
+
+  // Decreasing the highest value should not keep reporting it.
+  state_->SubDelta(250);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 100U);
+  EXPECT_EQ(state_->GetPeriodSum(), 150U);
+  state_->AddDelta(20);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 100U);
+
+  // The first day leaves the period without any update.
+  clock_->Advance(base::Days(2));
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 70U);
+  EXPECT_EQ(state_->GetPeriodSum(), 70U);
+  state_->AddDelta(5);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 70U);
+  EXPECT_EQ(state_->GetPeriodSum(), 75U);
+
+  // Both of the first days are gone now.
+  clock_->Advance(base::Days(1));
+  state_->AddDelta(1);
+  EXPECT_EQ(state_->GetHighestValueInPeriod(), 5U);
+  EXPECT_EQ(state_->GetPeriodSum(), 6U);
+}
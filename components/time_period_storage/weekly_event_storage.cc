@@ -5,7 +5,6 @@
 
 #include "brave/components/time_period_storage/weekly_event_storage.h"
 
-#include <list>
 #include <memory>
 #include <utility>
 
@@ -19,9 +18,18 @@
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace {
+
 static constexpr size_t kDaysInWeek = 7;
+
+base::Value ToPrefValue(base::Time day, int value) {
+  base::Value dict(base::Value::Type::DICTIONARY);
+  dict.SetKey("day", base::TimeToValue(day));
+  dict.SetIntKey("value", value);
+  return dict;
 }
 
+}  // namespace
+
 WeeklyEventStorage::WeeklyEventStorage(PrefService* prefs,
                                        const char* pref_name)
     : WeeklyEventStorage(prefs,
@@ -64,13 +72,12 @@ bool WeeklyEventStorage::HasEvent() {
 }
 
 void WeeklyEventStorage::FilterToWeek() {
-  if (events_.empty()) {
-    return;
-  }
-
-  // Remove all events older than a week.
+  // Remove all events older than a week. Events are kept most recent first,
+  // so these are at the back.
   auto cutoff = clock_->Now() - base::Days(kDaysInWeek);
-  events_.remove_if([cutoff](Event event) { return event.day <= cutoff; });
+  while (!events_.empty() && events_.back().day <= cutoff) {
+    events_.pop_back();
+  }
 }
 
 void WeeklyEventStorage::Load() {
@@ -83,6 +90,7 @@ void WeeklyEventStorage::Load() {
     const auto day = base::ValueToTime(it.FindKey("day"));
     const auto value = it.FindIntKey("value");
     if (!day || !value) {
+      pref_mirrors_events_ = false;
       continue;
     }
     events_.push_back({day.value(), value.value()});
@@ -90,13 +98,22 @@ void WeeklyEventStorage::Load() {
 }
 
 void WeeklyEventStorage::Save() {
+  DCHECK(!events_.empty());
   ListPrefUpdate update(prefs_, pref_name_);
   base::Value* list = update.Get();
-  list->ClearList();
-  for (const auto& u : events_) {
-    base::Value value(base::Value::Type::DICTIONARY);
-    value.SetKey("day", base::TimeToValue(u.day));
-    value.SetIntKey("value", static_cast<int>(u.value));
-    list->Append(std::move(value));
+  if (!pref_mirrors_events_ || list->GetList().size() + 1 < events_.size()) {
+    list->ClearList();
+    for (const auto& u : events_) {
+      list->Append(ToPrefValue(u.day, u.value));
+    }
+    pref_mirrors_events_ = true;
+    return;
+  }
+  // Since the last save only the most recent event was added and events at
+  // the back have expired.
+  const Event& latest = events_.front();
+  list->Insert(list->GetList().begin(), ToPrefValue(latest.day, latest.value));
+  while (list->GetList().size() > events_.size()) {
+    list->EraseListIter(list->GetList().end() - 1);
   }
 }
@@ -6,9 +6,9 @@
 #ifndef BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_WEEKLY_EVENT_STORAGE_H_
 #define BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_WEEKLY_EVENT_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
 #include "base/time/clock.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_service.h"
@@ -54,7 +54,8 @@ class WeeklyEventStorage {
 
   void FilterToWeek();
 
-  // Serialize event record to/from a pref.
+  // Serialize event record to/from a pref. Save() updates the pref list in
+  // place, unless it does not mirror |events_| yet.
   void Load();
   void Save();
 
@@ -62,7 +63,10 @@ class WeeklyEventStorage {
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<Event> events_;
+  // Most recent event first.
+  base::circular_deque<Event> events_;
+  // False when Load() skipped entries of the pref list.
+  bool pref_mirrors_events_ = true;
 };
 
 #endif  // BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_WEEKLY_EVENT_STORAGE_H_